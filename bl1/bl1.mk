@@ -29,6 +29,10 @@ ifeq (${ENABLE_PMF},1)
 BL1_SOURCES		+=	lib/pmf/pmf_main.c
 endif
 
+ifeq (${ENABLE_BOOT_TIMELINE},1)
+BL1_SOURCES		+=	lib/boot_timeline/boot_timeline.c
+endif
+
 ifneq ($(findstring gcc,$(notdir $(LD))),)
         BL1_LDFLAGS	+=	-Wl,--sort-section=alignment
 else ifneq ($(findstring ld,$(notdir $(LD))),)
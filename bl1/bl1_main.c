@@ -17,6 +17,7 @@
 #include <drivers/auth/auth_mod.h>
 #include <drivers/auth/crypto_mod.h>
 #include <drivers/console.h>
+#include <lib/boot_timeline.h>
 #include <lib/bootmarker_capture.h>
 #include <lib/cpus/errata.h>
 #include <lib/pmf/pmf.h>
@@ -133,6 +134,9 @@ void bl1_main(void)
 	/* Perform remaining generic architectural setup from EL3 */
 	bl1_arch_setup();
 
+	/* Start recording how long loading each image takes */
+	boot_timeline_init();
+
 	crypto_mod_init();
 
 	/* Initialize authentication module */
@@ -52,4 +52,13 @@ endif
 
 ifeq (${ENABLE_PMF},1)
 BL2_SOURCES		+=	lib/pmf/pmf_main.c
+endif
+
+ifeq (${ENABLE_BOOT_TIMELINE},1)
+BL2_SOURCES		+=	lib/boot_timeline/boot_timeline.c
+endif
+
+ifeq (${BL2_WORKERS},1)
+BL2_SOURCES		+=	bl2/bl2_workers.c			\
+				bl2/${ARCH}/bl2_worker_entrypoint.S
 endif
\ No newline at end of file
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -10,12 +10,14 @@
 #include <arch_features.h>
 #include <bl1/bl1.h>
 #include <bl2/bl2.h>
+#include <bl2/bl2_workers.h>
 #include <common/bl_common.h>
 #include <common/debug.h>
 #include <drivers/auth/auth_mod.h>
 #include <drivers/auth/crypto_mod.h>
 #include <drivers/console.h>
 #include <drivers/fwu/fwu.h>
+#include <lib/boot_timeline.h>
 #include <lib/bootmarker_capture.h>
 #include <lib/extensions/pauth.h>
 #include <lib/pmf/pmf.h>
@@ -98,6 +100,9 @@ void bl2_main(void)
 	/* Perform remaining generic architectural setup in S-EL1 */
 	bl2_arch_setup();
 
+	/* Start recording how long loading each image takes */
+	boot_timeline_init();
+
 #if PSA_FWU_SUPPORT
 	fwu_init();
 #endif /* PSA_FWU_SUPPORT */
@@ -113,9 +118,15 @@ void bl2_main(void)
 	/* Initialize boot source */
 	bl2_plat_preload_setup();
 
+	/* Release the secondary CPUs available to load images */
+	bl2_workers_start();
+
 	/* Load the subsequent bootloader images. */
 	next_bl_ep_info = bl2_load_images();
 
+	/* Return the secondary CPUs before BL2 memory may be reclaimed */
+	bl2_workers_stop();
+
 	/* Teardown the Measured Boot backend */
 	bl2_plat_mboot_finish();
 
@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+
+#include <arch_helpers.h>
+#include <bl2/bl2_workers.h>
+#include <common/bl_common.h>
+#include <common/debug.h>
+#include <drivers/delay_timer.h>
+#include <lib/utils.h>
+#include <lib/xlat_tables/xlat_tables_compat.h>
+#include <plat/common/platform.h>
+
+#include "bl2_private.h"
+
+/*
+ * Secondary CPUs released by the platform during cold boot run jobs for the
+ * primary CPU, such as hashing or decompressing the image chunk it has just
+ * read while it reads the next one. There is one job slot per CPU, only ever
+ * filled by the primary CPU.
+ */
+#define WORKER_OFF		U(0)
+#define WORKER_IDLE		U(1)
+#define WORKER_EXITING		U(2)
+
+/*
+ * How long bl2_workers_stop() waits for the workers to exit, and then for any
+ * CPU on its way out of the platform when the release is revoked
+ */
+#define BL2_WORKERS_STOP_TIMEOUT_US	U(100000)
+
+typedef struct bl2_worker {
+	volatile unsigned int state;
+	bl2_job_t *volatile job;
+} __aligned(CACHE_WRITEBACK_GRANULE) bl2_worker_t;
+
+static bl2_worker_t bl2_workers[PLATFORM_CORE_COUNT];
+static unsigned int bl2_workers_released;
+static volatile bool bl2_workers_stopping;
+
+/* Jobs of bl2_workers_zeromem(), one per CPU */
+static bl2_job_t zero_jobs[PLATFORM_CORE_COUNT];
+static struct {
+	void *mem;
+	size_t length;
+} zero_args[PLATFORM_CORE_COUNT];
+
+IMPORT_SYM(uintptr_t, __RW_START__, BL2_RW_BASE);
+
+/*******************************************************************************
+ * Release the secondary CPUs the platform makes available. This is a no-op on
+ * platforms that do not override bl2_plat_workers_start(), in which case jobs
+ * are run by the primary CPU when they are submitted.
+ ******************************************************************************/
+void bl2_workers_start(void)
+{
+	assert(bl2_workers_released == 0U);
+
+	/*
+	 * The workers start with their MMU off: make sure they see the data
+	 * they need to turn it on, such as their stack and the translation
+	 * table configuration.
+	 */
+	flush_dcache_range(BL2_RW_BASE, BL_END - BL2_RW_BASE);
+
+	bl2_workers_released =
+		bl2_plat_workers_start((uintptr_t)bl2_worker_entrypoint);
+	assert(bl2_workers_released < PLATFORM_CORE_COUNT);
+
+	VERBOSE("BL2: %u worker CPUs released\n", bl2_workers_released);
+}
+
+/*
+ * Count the workers that checked in and those the platform has taken back, i.e.
+ * that no longer run from BL2 memory.
+ */
+static void bl2_workers_count(unsigned int *checked_in, unsigned int *exited)
+{
+	unsigned int i, state;
+
+	*checked_in = 0U;
+	*exited = 0U;
+	for (i = 0U; i < PLATFORM_CORE_COUNT; i++) {
+		state = bl2_workers[i].state;
+		if (state != WORKER_OFF) {
+			(*checked_in)++;
+		}
+		if ((state == WORKER_EXITING) &&
+		    bl2_plat_worker_has_exited(i)) {
+			(*exited)++;
+		}
+	}
+}
+
+/*******************************************************************************
+ * Wait for the workers to be done and return them to the platform. This must
+ * be called before the memory used by BL2 may be overwritten. The release of
+ * the CPUs that never checked in is revoked, and a worker that does not exit
+ * in time may still be running BL2 code, so this panics.
+ ******************************************************************************/
+void bl2_workers_stop(void)
+{
+	unsigned int i, checked_in, exited;
+	uint64_t timeout;
+
+	bl2_workers_stopping = true;
+	dsbish();
+	sev();
+
+	timeout = timeout_init_us(BL2_WORKERS_STOP_TIMEOUT_US);
+	do {
+		bl2_workers_count(&checked_in, &exited);
+	} while ((exited < bl2_workers_released) && !timeout_elapsed(timeout));
+
+	if (checked_in < bl2_workers_released) {
+		WARN("BL2: %u worker CPUs released but never started\n",
+		     bl2_workers_released - checked_in);
+
+		/*
+		 * Keep them from leaving the platform later on, e.g. once it
+		 * lets CPUs go into the next image. One may have been on its
+		 * way already: give it the time to check in and exit.
+		 */
+		for (i = 0U; i < PLATFORM_CORE_COUNT; i++) {
+			if ((i != plat_my_core_pos()) &&
+			    (bl2_workers[i].state == WORKER_OFF)) {
+				bl2_plat_worker_revoke(i);
+			}
+		}
+
+		timeout = timeout_init_us(BL2_WORKERS_STOP_TIMEOUT_US);
+		do {
+			bl2_workers_count(&checked_in, &exited);
+		} while (!timeout_elapsed(timeout));
+	}
+
+	if (exited < checked_in) {
+		ERROR("BL2: %u worker CPUs did not stop\n", checked_in - exited);
+		panic();
+	}
+}
+
+/*******************************************************************************
+ * Return the number of workers ready to run jobs.
+ ******************************************************************************/
+unsigned int bl2_workers_available(void)
+{
+	unsigned int i, count = 0U;
+
+	for (i = 0U; i < PLATFORM_CORE_COUNT; i++) {
+		if (bl2_workers[i].state == WORKER_IDLE) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+/*******************************************************************************
+ * Run 'job' on an idle worker or, if there is none, right away.
+ ******************************************************************************/
+void bl2_workers_submit(bl2_job_t *job)
+{
+	unsigned int i;
+
+	assert((job != NULL) && (job->fn != NULL));
+
+	job->done = false;
+
+	for (i = 0U; i < PLATFORM_CORE_COUNT; i++) {
+		if ((bl2_workers[i].state == WORKER_IDLE) &&
+		    (bl2_workers[i].job == NULL)) {
+			/* Publish the job before handing it over */
+			dmbish();
+			bl2_workers[i].job = job;
+			dsbish();
+			sev();
+			return;
+		}
+	}
+
+	job->ret = job->fn(job->arg);
+	job->done = true;
+}
+
+/*******************************************************************************
+ * Wait for 'job' to complete and return its result.
+ ******************************************************************************/
+int bl2_workers_wait(bl2_job_t *job)
+{
+	while (!job->done) {
+		wfe();
+	}
+
+	/* Read the result only once the job is done */
+	dmbish();
+
+	return job->ret;
+}
+
+static int zero_job(void *arg)
+{
+	unsigned int i = (unsigned int)(uintptr_t)arg;
+
+	zero_normalmem(zero_args[i].mem, zero_args[i].length);
+
+	return 0;
+}
+
+/*******************************************************************************
+ * Zero normal memory, splitting the work between the primary CPU and the idle
+ * workers.
+ ******************************************************************************/
+void bl2_workers_zeromem(void *mem, size_t length)
+{
+	unsigned int parts = bl2_workers_available() + 1U;
+	size_t part_len;
+	uintptr_t base = (uintptr_t)mem;
+	unsigned int i;
+
+	if (parts > PLATFORM_CORE_COUNT) {
+		parts = PLATFORM_CORE_COUNT;
+	}
+
+	/* Keep the parts cache line aligned, the last one takes the rest */
+	part_len = round_down(length / parts, CACHE_WRITEBACK_GRANULE);
+	if (part_len == 0U) {
+		parts = 1U;
+	}
+
+	for (i = 0U; i < (parts - 1U); i++) {
+		zero_args[i].mem = (void *)base;
+		zero_args[i].length = part_len;
+		zero_jobs[i].fn = zero_job;
+		zero_jobs[i].arg = (void *)(uintptr_t)i;
+		bl2_workers_submit(&zero_jobs[i]);
+		base += part_len;
+	}
+
+	zero_normalmem((void *)base, length - (base - (uintptr_t)mem));
+
+	for (i = 0U; i < (parts - 1U); i++) {
+		(void)bl2_workers_wait(&zero_jobs[i]);
+	}
+}
+
+/*******************************************************************************
+ * Called by bl2_worker_entrypoint() before bl2_worker_main(), with the MMU off.
+ ******************************************************************************/
+void bl2_worker_setup(void)
+{
+#if BL2_RUNS_AT_EL3
+	enable_mmu_el3(0U);
+#else
+	enable_mmu_el1(0U);
+#endif
+	bl2_arch_setup();
+}
+
+/*******************************************************************************
+ * Job loop of the workers, left once bl2_workers_stop() is called.
+ ******************************************************************************/
+void bl2_worker_main(void)
+{
+	bl2_worker_t *worker = &bl2_workers[plat_my_core_pos()];
+	bl2_job_t *job;
+
+	worker->state = WORKER_IDLE;
+	dsbish();
+	sev();
+
+	for (;;) {
+		job = worker->job;
+		if (job != NULL) {
+			/* Read the job only once it has been handed over */
+			dmbish();
+			job->ret = job->fn(job->arg);
+			dmbish();
+			job->done = true;
+			worker->job = NULL;
+			dsbish();
+			sev();
+		} else if (bl2_workers_stopping) {
+			break;
+		} else {
+			wfe();
+		}
+	}
+
+	/*
+	 * This CPU still runs from BL2 memory until bl2_plat_worker_exit()
+	 * has taken it away, which the platform confirms to
+	 * bl2_workers_stop().
+	 */
+	worker->state = WORKER_EXITING;
+	dsbish();
+	sev();
+}
@@ -1,25 +1,146 @@
 /*
- * Copyright (c) 2013-2022, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
 #include <errno.h>
+#include <stdbool.h>
 #include <string.h>
 
 #include <arch.h>
 #include <arch_features.h>
 #include <arch_helpers.h>
+#if defined(IMAGE_BL2) && BL2_WORKERS
+#include <bl2/bl2_workers.h>
+#endif
 #include <common/bl_common.h>
 #include <common/debug.h>
 #include <drivers/auth/auth_mod.h>
+#include <drivers/auth/crypto_mod.h>
 #include <drivers/io/io_storage.h>
+#if MEASURED_BOOT && defined(TPM_ALG_ID)
+#include <drivers/measured_boot/event_log/event_log.h>
+#endif
+#include <lib/boot_timeline.h>
 #include <lib/utils.h>
 #include <lib/xlat_tables/xlat_tables_defs.h>
 #include <plat/common/platform.h>
 
+/* Size of the chunks an image is read in when it is hashed while loading */
+#define IMAGE_HASH_CHUNK_SIZE	U(0x10000)
+
+/* Consumer of the next image to be loaded, if any */
+static const image_load_stream_t *image_load_stream;
+
+/* Chunk of an image read by read_image(), to be hashed and/or streamed */
+typedef struct image_chunk {
+	uintptr_t base;
+	size_t size;
+	crypto_hash_ctx_t *hash_ctx;
+	unsigned int num_hash;
+	const image_load_stream_t *stream;
+} image_chunk_t;
+
+static int process_image_chunk(void *arg)
+{
+	const image_chunk_t *chunk = arg;
+#if TRUSTED_BOARD_BOOT
+	unsigned int i;
+
+	for (i = 0U; i < chunk->num_hash; i++) {
+		if (crypto_mod_hash_update(&chunk->hash_ctx[i],
+					   (void *)chunk->base,
+					   chunk->size) != 0) {
+			return -EAUTH;
+		}
+	}
+#endif /* TRUSTED_BOARD_BOOT */
+
+	if (chunk->stream != NULL) {
+		return chunk->stream->write(chunk->base, chunk->size);
+	}
+
+	return 0;
+}
+
+#if defined(IMAGE_BL2) && BL2_WORKERS
+# define IMAGE_LOAD_WORKERS	1
+
+/*
+ * A chunk is processed by a worker CPU while the next one is read. Chunks are
+ * processed in order, so there is only ever one in flight.
+ */
+static image_chunk_t image_chunk;
+static bl2_job_t image_chunk_job = {
+	.fn = process_image_chunk,
+	.arg = &image_chunk,
+	.done = true,
+};
+
+/* Wait for the previous chunk to be processed */
+static int wait_image_chunk(void)
+{
+	int rc = bl2_workers_wait(&image_chunk_job);
+
+	image_chunk_job.ret = 0;
+
+	return rc;
+}
+
+static int submit_image_chunk(image_chunk_t *chunk)
+{
+	int rc = wait_image_chunk();
+
+	if (rc != 0) {
+		return rc;
+	}
+
+	image_chunk = *chunk;
+	bl2_workers_submit(&image_chunk_job);
+
+	return 0;
+}
+#else
+# define IMAGE_LOAD_WORKERS	0
+
+static int wait_image_chunk(void)
+{
+	return 0;
+}
+
+static int submit_image_chunk(image_chunk_t *chunk)
+{
+	return process_image_chunk(chunk);
+}
+#endif /* defined(IMAGE_BL2) && BL2_WORKERS */
+
+/* Zero a rejected image and flush it right away */
+static void wipe_image(uintptr_t base, size_t size)
+{
+#if IMAGE_LOAD_WORKERS
+	bl2_workers_zeromem((void *)base, size);
+#else
+	zero_normalmem((void *)base, size);
+#endif
+	flush_dcache_range(base, size);
+}
+
 #if TRUSTED_BOARD_BOOT
+/*
+ * Number of hashes calculated while loading an image: the one it is
+ * authenticated with and, if it uses another algorithm, the Event Log one.
+ */
+# if MEASURED_BOOT && defined(TPM_ALG_ID)
+#  define IMAGE_HASH_NUM	U(2)
+# else
+#  define IMAGE_HASH_NUM	U(1)
+# endif
+
+/* Contexts of the hashes calculated while loading an image */
+static crypto_hash_ctx_t img_hash_ctx[IMAGE_HASH_NUM];
+
 # ifdef DYN_DISABLE_AUTH
 static int disable_auth;
 
@@ -59,15 +180,122 @@ uintptr_t page_align(uintptr_t value, unsigned dir)
 	return value;
 }
 
+/*******************************************************************************
+ * Set the consumer of the next image loaded by load_auth_image(), or stop
+ * streaming images if 'stream' is NULL. The consumer is only used by the next
+ * call to load_auth_image(), whatever its outcome.
+ ******************************************************************************/
+void set_image_load_stream(const image_load_stream_t *stream)
+{
+	assert((stream == NULL) ||
+	       ((stream->buf_size != 0U) && (stream->start != NULL) &&
+		(stream->write != NULL) && (stream->end != NULL)));
+
+	image_load_stream = stream;
+}
+
+/*******************************************************************************
+ * Internal function to read an opened image into memory. If 'num_hash' is not
+ * zero, the image is read in chunks and each chunk is added to the hashes in
+ * 'hash_ctx' while it is still in the cache, instead of the whole image being
+ * read back later. If 'stream' is not NULL, the chunks are read into its
+ * buffer and passed on to it instead of being stored at 'image_base'. With
+ * BL2_WORKERS, this is done by a worker CPU while the next chunk is read.
+ ******************************************************************************/
+static int read_image(uintptr_t image_handle, uintptr_t image_base,
+		      size_t image_size, size_t *bytes_read,
+		      crypto_hash_ctx_t *hash_ctx, unsigned int num_hash,
+		      const image_load_stream_t *stream)
+{
+	image_chunk_t chunk;
+	size_t chunk_size, max_size;
+	unsigned int num_buf = 1U, buf = 0U;
+	bool chunk_inline = (stream != NULL);
+	int io_result = 0;
+	int rc;
+
+	if ((num_hash == 0U) && (stream == NULL)) {
+		return io_read(image_handle, image_base, image_size,
+			       bytes_read);
+	}
+
+	chunk.hash_ctx = hash_ctx;
+	chunk.num_hash = num_hash;
+	chunk.stream = stream;
+
+	/*
+	 * Read into one half of the stream buffer while a worker uses the
+	 * other. A single stream buffer is read into again right away, so its
+	 * chunks are processed inline even if a worker becomes available.
+	 */
+#if IMAGE_LOAD_WORKERS
+	if ((stream != NULL) && (stream->buf_size >= 2U) &&
+	    (bl2_workers_available() != 0U)) {
+		num_buf = 2U;
+		chunk_inline = false;
+	}
+#endif
+
+	*bytes_read = 0U;
+	while (*bytes_read < image_size) {
+		chunk_size = image_size - *bytes_read;
+		if (stream != NULL) {
+			max_size = stream->buf_size / num_buf;
+			chunk.base = stream->buf_base + (buf * max_size);
+			buf = (buf + 1U) % num_buf;
+		} else {
+			max_size = IMAGE_HASH_CHUNK_SIZE;
+			chunk.base = image_base + *bytes_read;
+		}
+		if (chunk_size > max_size) {
+			chunk_size = max_size;
+		}
+
+		io_result = io_read(image_handle, chunk.base, chunk_size,
+				    &chunk.size);
+		if (io_result != 0) {
+			break;
+		}
+
+		if (chunk_inline) {
+			io_result = process_image_chunk(&chunk);
+		} else {
+			io_result = submit_image_chunk(&chunk);
+		}
+		if (io_result != 0) {
+			break;
+		}
+
+		*bytes_read += chunk.size;
+		if (chunk.size < chunk_size) {
+			break;
+		}
+	}
+
+	/* The last chunk must be processed before the hashes are final */
+	rc = wait_image_chunk();
+	if (io_result == 0) {
+		io_result = rc;
+	}
+
+	return io_result;
+}
+
 /*******************************************************************************
  * Internal function to load an image at a specific address given
- * an image ID and extents of free memory.
+ * an image ID and extents of free memory. The image is also added to the
+ * 'num_hash' hashes in 'hash_ctx' and, if 'stream' is not NULL, passed to it
+ * rather than being stored at image_base. The size of what the stream stored
+ * is then returned in 'stream_size', while image_size remains the size of the
+ * data read. If streaming fails, whatever it stored is wiped.
  *
  * If the load is successful then the image information is updated.
  *
  * Returns 0 on success, a negative error code otherwise.
  ******************************************************************************/
-static int load_image(unsigned int image_id, image_info_t *image_data)
+static int load_image(unsigned int image_id, image_info_t *image_data,
+		      crypto_hash_ctx_t *hash_ctx, unsigned int num_hash,
+		      const image_load_stream_t *stream, size_t *stream_size)
 {
 	uintptr_t dev_handle;
 	uintptr_t image_handle;
@@ -75,6 +303,8 @@ static int load_image(unsigned int image_id, image_info_t *image_data)
 	uintptr_t image_base;
 	size_t image_size;
 	size_t bytes_read;
+	uint64_t phase_start;
+	bool streaming = false;
 	int io_result;
 
 	assert(image_data != NULL);
@@ -82,6 +312,8 @@ static int load_image(unsigned int image_id, image_info_t *image_data)
 
 	image_base = image_data->image_base;
 
+	phase_start = boot_timeline_now();
+
 	/* Obtain a reference to the image by querying the platform layer */
 	io_result = plat_get_image_source(image_id, &dev_handle, &image_spec);
 	if (io_result != 0) {
@@ -98,6 +330,8 @@ static int load_image(unsigned int image_id, image_info_t *image_data)
 		return io_result;
 	}
 
+	boot_timeline_record(image_id, BOOT_PHASE_OPEN, phase_start);
+
 	INFO("Loading image id=%u at address 0x%lx\n", image_id, image_base);
 
 	/* Find the size of the image */
@@ -121,18 +355,53 @@ static int load_image(unsigned int image_id, image_info_t *image_data)
 	 */
 	image_data->image_size = (uint32_t)image_size;
 
+	phase_start = boot_timeline_now();
+
+	if (stream != NULL) {
+		io_result = stream->start(image_data);
+		if (io_result != 0) {
+			WARN("Failed to start streaming image id=%u (%i)\n",
+			     image_id, io_result);
+			goto exit;
+		}
+		streaming = true;
+	}
+
 	/* We have enough space so load the image now */
 	/* TODO: Consider whether to try to recover/retry a partially successful read */
-	io_result = io_read(image_handle, image_base, image_size, &bytes_read);
+	io_result = read_image(image_handle, image_base, image_size,
+			       &bytes_read, hash_ctx, num_hash, stream);
 	if ((io_result != 0) || (bytes_read < image_size)) {
 		WARN("Failed to load image id=%u (%i)\n", image_id, io_result);
 		goto exit;
 	}
 
+	/* This includes hashing and decompressing the image while reading it */
+	boot_timeline_record(image_id, BOOT_PHASE_READ, phase_start);
+
+	if (stream != NULL) {
+		/* The stream decides what ends up at image_base */
+		phase_start = boot_timeline_now();
+		io_result = stream->end(image_data, stream_size);
+		if (io_result != 0) {
+			WARN("Failed to complete streaming image id=%u (%i)\n",
+			     image_id, io_result);
+			goto exit;
+		}
+		boot_timeline_record(image_id, BOOT_PHASE_DECOMPRESS,
+				     phase_start);
+		image_size = *stream_size;
+	}
+
 	INFO("Image id=%u loaded: 0x%lx - 0x%lx\n", image_id, image_base,
 	     (uintptr_t)(image_base + image_size));
 
 exit:
+	if ((io_result != 0) && streaming) {
+		/* The stream may have stored anything up to image_max_size */
+		wipe_image(image_base, image_data->image_max_size);
+	}
+
 	(void)io_close(image_handle);
 	/* Ignore improbable/unrecoverable error in 'close' */
 
@@ -154,6 +423,10 @@ static int load_auth_image_recursive(unsigned int image_id,
 {
 	int rc;
 	unsigned int parent_id;
+	unsigned int num_hash = 0U;
+	unsigned int i;
+	unsigned char digest[CRYPTO_MD_MAX_SIZE];
+	uint64_t auth_start;
 
 	/* Use recursion to authenticate parent images */
 	rc = auth_mod_get_parent_id(image_id, &parent_id);
@@ -164,22 +437,54 @@ static int load_auth_image_recursive(unsigned int image_id,
 		}
 	}
 
-	/* Load the image */
-	rc = load_image(image_id, image_data);
+	/*
+	 * Load the image. Images authenticated by their hash are hashed as
+	 * they are read, so auth_mod_verify_img() need not read them again.
+	 */
+	if (auth_mod_hash_img_start(image_id, &img_hash_ctx[0]) == 0) {
+		num_hash = 1U;
+#if IMAGE_HASH_NUM > 1
+		/*
+		 * The image is measured once authenticated: calculate the
+		 * Event Log hash in the same pass if the algorithms differ
+		 * and the platform records the image in the Event Log.
+		 */
+		if ((is_parent_image == 0) &&
+		    (img_hash_ctx[0].md_alg != EVENT_LOG_MD_ID) &&
+		    plat_mboot_is_event_log_image(image_id) &&
+		    (crypto_mod_hash_init(&img_hash_ctx[1],
+					  EVENT_LOG_MD_ID) == 0)) {
+			num_hash = 2U;
+		}
+#endif
+	}
+
+	rc = load_image(image_id, image_data, img_hash_ctx, num_hash, NULL,
+			NULL);
+
+	/* Record the digests for auth_mod_verify_img() and measured boot */
+	for (i = 0U; i < num_hash; i++) {
+		if ((crypto_mod_hash_final(&img_hash_ctx[i], digest) == 0) &&
+		    (rc == 0)) {
+			crypto_mod_record_hash(img_hash_ctx[i].md_alg,
+					       (void *)image_data->image_base,
+					       image_data->image_size, digest);
+		}
+	}
+
 	if (rc != 0) {
 		return rc;
 	}
 
 	/* Authenticate it */
+	auth_start = boot_timeline_now();
 	rc = auth_mod_verify_img(image_id,
 				 (void *)image_data->image_base,
 				 image_data->image_size);
+	boot_timeline_record(image_id, BOOT_PHASE_AUTH, auth_start);
 	if (rc != 0) {
 		/* Authentication error, zero memory and flush it right away. */
-		zero_normalmem((void *)image_data->image_base,
-			       image_data->image_size);
-		flush_dcache_range(image_data->image_base,
-				   image_data->image_size);
+		wipe_image(image_data->image_base, image_data->image_size);
 		return -EAUTH;
 	}
 
@@ -188,15 +493,37 @@ static int load_auth_image_recursive(unsigned int image_id,
 #endif /* TRUSTED_BOARD_BOOT */
 
 static int load_auth_image_internal(unsigned int image_id,
-				    image_info_t *image_data)
+				    image_info_t *image_data,
+				    const image_load_stream_t *stream)
 {
+	size_t stream_size = 0U;
+	int rc;
+
 #if TRUSTED_BOARD_BOOT
+	/* Forget the digests recorded while loading any previous image */
+	crypto_mod_clear_recorded_hashes();
+
 	if (dyn_is_auth_disabled() == 0) {
+		/*
+		 * A streamed image is transformed before it can be
+		 * authenticated, and its source is gone by then.
+		 */
+		if (stream != NULL) {
+			ERROR("Image id=%u cannot be streamed with Trusted "
+			      "Board Boot\n", image_id);
+			return -EPERM;
+		}
+
 		return load_auth_image_recursive(image_id, image_data, 0);
 	}
 #endif
 
-	return load_image(image_id, image_data);
+	rc = load_image(image_id, image_data, NULL, 0U, stream, &stream_size);
+	if ((rc == 0) && (stream != NULL)) {
+		image_data->image_size = (uint32_t)stream_size;
+	}
+
+	return rc;
 }
 
 /*******************************************************************************
@@ -208,18 +535,23 @@ static int load_auth_image_internal(unsigned int image_id,
  ******************************************************************************/
 int load_auth_image(unsigned int image_id, image_info_t *image_data)
 {
+	const image_load_stream_t *stream = image_load_stream;
+	uint64_t measure_start;
 	int err;
 
+	/* The stream only applies to this image, whether it loads or not */
+	image_load_stream = NULL;
+
 /*
  * All firmware banks should be part of the same non-volatile storage as per
  * PSA FWU specification, hence don't check for any alternate boot source
  * when PSA FWU is enabled.
  */
 #if PSA_FWU_SUPPORT
-	err = load_auth_image_internal(image_id, image_data);
+	err = load_auth_image_internal(image_id, image_data, stream);
 #else
 	do {
-		err = load_auth_image_internal(image_id, image_data);
+		err = load_auth_image_internal(image_id, image_data, stream);
 	} while ((err != 0) && (plat_try_next_boot_source() != 0));
 #endif /* PSA_FWU_SUPPORT */
 
@@ -229,20 +561,31 @@ int load_auth_image(unsigned int image_id, image_info_t *image_data)
 		 * authentication in case of Trusted-Boot flow) then measure
 		 * it (if MEASURED_BOOT flag is enabled).
 		 */
+		measure_start = boot_timeline_now();
 		err = plat_mboot_measure_image(image_id, image_data);
-		if (err != 0) {
-			return err;
-		}
+		boot_timeline_record(image_id, BOOT_PHASE_MEASURE,
+				     measure_start);
+	}
 
-		/*
-		 * Flush the image to main memory so that it can be executed
-		 * later by any CPU, regardless of cache and MMU state.
-		 */
-		flush_dcache_range(image_data->image_base,
-				   image_data->image_size);
+#if TRUSTED_BOARD_BOOT
+	/*
+	 * The digests recorded while loading the image are used up, or were
+	 * calculated over an image that has been rejected since.
+	 */
+	crypto_mod_clear_recorded_hashes();
+#endif
+
+	if (err != 0) {
+		return err;
 	}
 
-	return err;
+	/*
+	 * Flush the image to main memory so that it can be executed
+	 * later by any CPU, regardless of cache and MMU state.
+	 */
+	flush_dcache_range(image_data->image_base, image_data->image_size);
+
+	return 0;
 }
 
 /*******************************************************************************
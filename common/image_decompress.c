@@ -1,32 +1,110 @@
 /*
- * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2018-2026, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 #include <arch_helpers.h>
 #include <common/bl_common.h>
 #include <common/debug.h>
 #include <common/image_decompress.h>
+#include <lib/boot_timeline.h>
 
 static uintptr_t decompressor_buf_base;
 static uint32_t decompressor_buf_size;
 static decompressor_t *decompressor;
 static struct image_info saved_image_info;
 
+static uintptr_t decompressor_work_base;
+static uint32_t decompressor_work_size;
+static const decompressor_stream_t *stream_decompressor;
+/* Whether the last image was completely decompressed while it was loaded */
+static bool stream_decompressed;
+
 void image_decompress_init(uintptr_t buf_base, uint32_t buf_size,
 			   decompressor_t *_decompressor)
 {
 	decompressor_buf_base = buf_base;
 	decompressor_buf_size = buf_size;
 	decompressor = _decompressor;
+	stream_decompressor = NULL;
+}
+
+static int image_decompress_start(const struct image_info *info)
+{
+	stream_decompressed = false;
+
+	return stream_decompressor->init(info->image_base,
+					 info->image_max_size,
+					 decompressor_work_base,
+					 decompressor_work_size);
+}
+
+static int image_decompress_write(uintptr_t buf, size_t len)
+{
+	return stream_decompressor->feed(buf, len);
+}
+
+static int image_decompress_end(const struct image_info *info, size_t *size)
+{
+	uintptr_t image_end;
+	int ret;
+
+	ret = stream_decompressor->end(&image_end);
+	if (ret != 0) {
+		ERROR("Failed to decompress image (err=%d)\n", ret);
+		return ret;
+	}
+
+	*size = image_end - info->image_base;
+	stream_decompressed = true;
+
+	return 0;
+}
+
+static image_load_stream_t image_decompress_stream = {
+	.start = image_decompress_start,
+	.write = image_decompress_write,
+	.end = image_decompress_end,
+};
+
+/*
+ * Decompress images while they are loaded instead of loading them whole into
+ * a temporary buffer first. The compressed data goes through the 'buf_size'
+ * bytes at 'buf_base', which can be much smaller than the images, and
+ * 'work_base' is the workspace of the decompressor.
+ */
+void image_decompress_init_stream(uintptr_t buf_base, uint32_t buf_size,
+				  uintptr_t work_base, uint32_t work_size,
+				  const decompressor_stream_t *_decompressor)
+{
+	assert(_decompressor != NULL);
+
+	image_decompress_stream.buf_base = buf_base;
+	image_decompress_stream.buf_size = buf_size;
+	decompressor_work_base = work_base;
+	decompressor_work_size = work_size;
+	stream_decompressor = _decompressor;
+	decompressor = NULL;
 }
 
 void image_decompress_prepare(struct image_info *info)
 {
+	if (stream_decompressor != NULL) {
+		/*
+		 * The image is decompressed to its final destination as it is
+		 * loaded, so image_info need not be changed.
+		 */
+		stream_decompressed = false;
+		set_image_load_stream(&image_decompress_stream);
+		return;
+	}
+
 	/*
 	 * If the image is compressed, it should be loaded into the temporary
 	 * buffer instead of its final destination.  We save image_info, then
@@ -42,8 +120,19 @@ int image_decompress(struct image_info *info)
 {
 	uintptr_t compressed_image_base, image_base, work_base;
 	uint32_t compressed_image_size, work_size;
+	uint64_t start;
 	int ret;
 
+	if (stream_decompressor != NULL) {
+		/* Decompressed and flushed by load_auth_image(), if it worked */
+		if (!stream_decompressed) {
+			ERROR("Image was not decompressed while loading\n");
+			return -EINVAL;
+		}
+		stream_decompressed = false;
+		return 0;
+	}
+
 	/*
 	 * The size of compressed data has been filled by load_image().
 	 * Read it out before restoring image_info.
@@ -63,9 +152,13 @@ int image_decompress(struct image_info *info)
 	work_base = compressed_image_base + compressed_image_size;
 	work_size = decompressor_buf_size - compressed_image_size;
 
+	start = boot_timeline_now();
 	ret = decompressor(&compressed_image_base, compressed_image_size,
 			   &image_base, info->image_max_size,
 			   work_base, work_size);
+	/* This is called right after loading the image */
+	boot_timeline_record(BOOT_TIMELINE_LAST_IMAGE, BOOT_PHASE_DECOMPRESS,
+			     start);
 	if (ret) {
 		ERROR("Failed to decompress image (err=%d)\n", ret);
 		return ret;
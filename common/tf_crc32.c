@@ -1,16 +1,29 @@
 /*
- * Copyright (c) 2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2021-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <stdarg.h>
 #include <assert.h>
+#include <string.h>
 
+#if defined(__ARM_FEATURE_CRC32)
 #include <arm_acle.h>
+#endif
 #include <common/debug.h>
 #include <common/tf_crc32.h>
 
+#if defined(__ARM_FEATURE_CRC32)
+
+#ifdef __aarch64__
+typedef uint64_t crc_word_t;
+#define crc32_word(crc, word)	__crc32d((crc), (word))
+#else
+typedef uint32_t crc_word_t;
+#define crc32_word(crc, word)	__crc32w((crc), (word))
+#endif
+
 /* compute CRC using Arm intrinsic function
  *
  * This function is useful for the platforms with the CPU ARMv8.0
@@ -18,6 +31,9 @@
  * Platforms with CPU ARMv8.0 should make sure to add a compile switch
  * '-march=armv8-a+crc" for successful compilation of this file.
  *
+ * The bulk of the buffer is consumed a whole word at a time, only the
+ * unaligned head and the tail are processed byte by byte.
+ *
  * @crc: previous accumulated CRC
  * @buf: buffer base address
  * @size: the size of the buffer
@@ -31,9 +47,31 @@ uint32_t tf_crc32(uint32_t crc, const unsigned char *buf, size_t size)
 	uint32_t calc_crc = ~crc;
 	const unsigned char *local_buf = buf;
 	size_t local_size = size;
+	crc_word_t word;
+
+	/*
+	 * calculate CRC over byte data up to the first aligned word
+	 */
+	while ((local_size != 0UL) &&
+	       (((uintptr_t)local_buf & (sizeof(crc_word_t) - 1U)) != 0U)) {
+		calc_crc = __crc32b(calc_crc, *local_buf);
+		local_buf++;
+		local_size--;
+	}
+
+	/*
+	 * calculate CRC over aligned words, memcpy() compiles down to a
+	 * single load here
+	 */
+	while (local_size >= sizeof(crc_word_t)) {
+		(void)memcpy(&word, local_buf, sizeof(word));
+		calc_crc = crc32_word(calc_crc, word);
+		local_buf += sizeof(crc_word_t);
+		local_size -= sizeof(crc_word_t);
+	}
 
 	/*
-	 * calculate CRC over byte data
+	 * calculate CRC over the remaining byte data
 	 */
 	while (local_size != 0UL) {
 		calc_crc = __crc32b(calc_crc, *local_buf);
@@ -43,3 +81,48 @@ uint32_t tf_crc32(uint32_t crc, const unsigned char *buf, size_t size)
 
 	return ~calc_crc;
 }
+
+#else /* !__ARM_FEATURE_CRC32 */
+
+/*
+ * CRC-32 (polynomial 0xEDB88320, reflected) of each 4-bit value, used to
+ * process the data a nibble at a time while keeping the table small.
+ */
+static const uint32_t crc32_nibble_table[16] = {
+	0x00000000U, 0x1db71064U, 0x3b6e20c8U, 0x26d930acU,
+	0x76dc4190U, 0x6b6b51f4U, 0x4db26158U, 0x5005713cU,
+	0xedb88320U, 0xf00f9344U, 0xd6d6a3e8U, 0xcb61b38cU,
+	0x9b64c2b0U, 0x86d3d2d4U, 0xa00ae278U, 0xbdbdf21cU,
+};
+
+/* compute CRC using a lookup table
+ *
+ * Portable fallback for CPUs, or builds, without the CRC32 instructions.
+ * It produces the same result as the Arm intrinsic based version.
+ *
+ * @crc: previous accumulated CRC
+ * @buf: buffer base address
+ * @size: the size of the buffer
+ *
+ * Return calculated CRC value
+ */
+uint32_t tf_crc32(uint32_t crc, const unsigned char *buf, size_t size)
+{
+	assert(buf != NULL);
+
+	uint32_t calc_crc = ~crc;
+	const unsigned char *local_buf = buf;
+	size_t local_size = size;
+
+	while (local_size != 0UL) {
+		calc_crc ^= *local_buf;
+		calc_crc = (calc_crc >> 4) ^ crc32_nibble_table[calc_crc & 0xfU];
+		calc_crc = (calc_crc >> 4) ^ crc32_nibble_table[calc_crc & 0xfU];
+		local_buf++;
+		local_size--;
+	}
+
+	return ~calc_crc;
+}
+
+#endif /* __ARM_FEATURE_CRC32 */
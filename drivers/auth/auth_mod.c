@@ -1,10 +1,11 @@
 /*
- * Copyright (c) 2015-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -25,8 +26,23 @@
 /* ASN.1 tags */
 #define ASN1_INTEGER                 0x02
 
+/* Number of platform NV counters whose value is cached */
+#define NV_CTR_CACHE_SIZE            4U
+
 #pragma weak plat_set_nv_ctr2
 
+/*
+ * Platform NV counter values read so far in this boot stage. Parent
+ * certificates are only authenticated once (see auth_img_flags), but most
+ * certificates in a CoT check the same one or two counters, which may be
+ * slow to read from the platform.
+ */
+static struct {
+	void *cookie;
+	unsigned int nv_ctr;
+	bool valid;
+} nv_ctr_cache[NV_CTR_CACHE_SIZE];
+
 static int cmp_auth_param_type_desc(const auth_param_type_desc_t *a,
 		const auth_param_type_desc_t *b)
 {
@@ -61,6 +77,35 @@ static int auth_get_param(const auth_param_type_desc_t *param_type_desc,
 	return 1;
 }
 
+/*
+ * Check a digest of the image recorded while it was being loaded against the
+ * DER encoded DigestInfo obtained from the parent image.
+ *
+ * Return: 0 = match, 1 = no digest recorded, Otherwise = mismatch
+ */
+static int verify_img_digest(void *data_ptr, unsigned int data_len,
+			     void *hash_der_ptr, unsigned int hash_der_len)
+{
+	unsigned char digest[CRYPTO_MD_MAX_SIZE];
+	enum crypto_md_algo md_alg;
+	void *hash_ptr;
+	unsigned int hash_len;
+
+	if ((crypto_mod_get_digest_info(hash_der_ptr, hash_der_len, &md_alg,
+					&hash_ptr, &hash_len) != 0) ||
+	    (crypto_mod_get_recorded_hash(md_alg, data_ptr, data_len,
+					  digest) != 0)) {
+		return 1;
+	}
+
+	if ((hash_len > CRYPTO_MD_MAX_SIZE) ||
+	    (memcmp(hash_ptr, digest, hash_len) != 0)) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	return 0;
+}
+
 /*
  * Authenticate an image by matching the data hash
  *
@@ -113,9 +158,13 @@ static int auth_hash(const auth_method_param_hash_t *param,
 		return rc;
 	}
 
-	/* Ask the crypto module to verify this hash */
-	rc = crypto_mod_verify_hash(data_ptr, data_len,
-				    hash_der_ptr, hash_der_len);
+	/* Use the digest calculated while the image was loaded, if any */
+	rc = verify_img_digest(data_ptr, data_len, hash_der_ptr, hash_der_len);
+	if (rc == 1) {
+		/* Ask the crypto module to verify this hash */
+		rc = crypto_mod_verify_hash(data_ptr, data_len,
+					    hash_der_ptr, hash_der_len);
+	}
 	if (rc != 0) {
 		VERBOSE("[TBB] %s():%d failed with error code %d.\n",
 			__func__, __LINE__, rc);
@@ -302,6 +351,48 @@ static int auth_signature(const auth_method_param_sig_t *param,
 	return 0;
 }
 
+/*
+ * Read a platform NV counter, using the cached value if there is one.
+ */
+static int get_plat_nv_ctr(void *cookie, unsigned int *nv_ctr)
+{
+	unsigned int i, free_slot = NV_CTR_CACHE_SIZE;
+	int rc;
+
+	for (i = 0U; i < NV_CTR_CACHE_SIZE; i++) {
+		if (!nv_ctr_cache[i].valid) {
+			free_slot = i;
+		} else if (nv_ctr_cache[i].cookie == cookie) {
+			*nv_ctr = nv_ctr_cache[i].nv_ctr;
+			return 0;
+		}
+	}
+
+	rc = plat_get_nv_ctr(cookie, nv_ctr);
+	if ((rc == 0) && (free_slot < NV_CTR_CACHE_SIZE)) {
+		nv_ctr_cache[free_slot].cookie = cookie;
+		nv_ctr_cache[free_slot].nv_ctr = *nv_ctr;
+		nv_ctr_cache[free_slot].valid = true;
+	}
+
+	return rc;
+}
+
+/*
+ * Drop the cached value of a platform NV counter so that it is read back
+ * after an update attempt, whatever the platform actually stored.
+ */
+static void invalidate_plat_nv_ctr(void *cookie)
+{
+	unsigned int i;
+
+	for (i = 0U; i < NV_CTR_CACHE_SIZE; i++) {
+		if (nv_ctr_cache[i].valid && (nv_ctr_cache[i].cookie == cookie)) {
+			nv_ctr_cache[i].valid = false;
+		}
+	}
+}
+
 /*
  * Authenticate by Non-Volatile counter
  *
@@ -376,7 +467,7 @@ static int auth_nvctr(const auth_method_param_nv_ctr_t *param,
 	}
 
 	/* Get the counter from the platform */
-	rc = plat_get_nv_ctr(param->plat_nv_ctr->cookie, &plat_nv_ctr);
+	rc = get_plat_nv_ctr(param->plat_nv_ctr->cookie, &plat_nv_ctr);
 	if (rc != 0) {
 		VERBOSE("[TBB] %s():%d failed with error code %d.\n",
 			__func__, __LINE__, rc);
@@ -432,6 +523,79 @@ int auth_mod_get_parent_id(unsigned int img_id, unsigned int *parent_id)
 	return 0;
 }
 
+/*
+ * Return the hash method of an image that is authenticated only by the hash
+ * of its whole contents, or NULL if it is authenticated in any other way.
+ */
+static const auth_method_param_hash_t *get_img_hash_param(
+					const auth_img_desc_t *img_desc)
+{
+	const auth_method_param_hash_t *hash_param = NULL;
+	const auth_method_desc_t *auth_method;
+	int i;
+
+	if ((img_desc->img_type != IMG_RAW) || (img_desc->parent == NULL) ||
+	    (img_desc->img_auth_methods == NULL)) {
+		return NULL;
+	}
+
+	for (i = 0 ; i < AUTH_METHOD_NUM ; i++) {
+		auth_method = &img_desc->img_auth_methods[i];
+		if (auth_method->type == AUTH_METHOD_NONE) {
+			continue;
+		}
+		if ((auth_method->type != AUTH_METHOD_HASH) ||
+		    (hash_param != NULL)) {
+			return NULL;
+		}
+		hash_param = &auth_method->param.hash;
+	}
+
+	return hash_param;
+}
+
+/*
+ * Start hashing an image while it is loaded. This is only possible for raw
+ * images authenticated by hash, once their parent has been authenticated.
+ * The caller feeds the image to crypto_mod_hash_update() as it is read, then
+ * completes the hash and passes it to crypto_mod_record_hash() for
+ * auth_mod_verify_img() to use.
+ *
+ * Return: 0 = hash started, Otherwise = the image must be hashed after loading
+ */
+int auth_mod_hash_img_start(unsigned int img_id, crypto_hash_ctx_t *ctx)
+{
+	const auth_img_desc_t *img_desc;
+	const auth_method_param_hash_t *hash_param;
+	enum crypto_md_algo md_alg;
+	void *hash_der_ptr, *hash_ptr;
+	unsigned int hash_der_len, hash_len;
+	int rc;
+
+	assert(ctx != NULL);
+
+	img_desc = FCONF_GET_PROPERTY(tbbr, cot, img_id);
+	hash_param = get_img_hash_param(img_desc);
+	if (hash_param == NULL) {
+		return 1;
+	}
+
+	/* The algorithm to use is given by the parent's hash of the image */
+	rc = auth_get_param(hash_param->hash, img_desc->parent,
+			    &hash_der_ptr, &hash_der_len);
+	if (rc != 0) {
+		return rc;
+	}
+
+	rc = crypto_mod_get_digest_info(hash_der_ptr, hash_der_len, &md_alg,
+					&hash_ptr, &hash_len);
+	if (rc != 0) {
+		return rc;
+	}
+
+	return crypto_mod_hash_init(ctx, md_alg);
+}
+
 /*
  * Initialize the different modules in the authentication framework
  */
@@ -519,6 +683,7 @@ int auth_mod_verify_img(unsigned int img_id,
 	if (need_nv_ctr_upgrade && sig_auth_done) {
 		rc = plat_set_nv_ctr2(nv_ctr_param->plat_nv_ctr->cookie,
 				      img_desc, cert_nv_ctr);
+		invalidate_plat_nv_ctr(nv_ctr_param->plat_nv_ctr->cookie);
 		if (rc != 0) {
 			VERBOSE("[TBB] %s():%d failed with error code %d.\n",
 				__func__, __LINE__, rc);
@@ -1,16 +1,30 @@
 /*
- * Copyright (c) 2015-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
+#include <stdbool.h>
+#include <string.h>
 
 #include <common/debug.h>
 #include <drivers/auth/crypto_mod.h>
 
 /* Variable exported by the crypto library through REGISTER_CRYPTO_LIB() */
 
+/*
+ * Digests recorded by crypto_mod_record_hash(), e.g. while an image was
+ * loaded, so that they need not be calculated again.
+ */
+static struct {
+	const void *data_ptr;
+	unsigned int data_len;
+	enum crypto_md_algo alg;
+	bool valid;
+	unsigned char hash[CRYPTO_MD_MAX_SIZE];
+} hash_records[CRYPTO_HASH_RECORD_NUM];
+
 /*
  * The crypto module is responsible for verifying digital signatures and hashes.
  * It relies on a crypto library to perform the cryptographic operations.
@@ -142,6 +156,170 @@ int crypto_mod_calc_hash(enum crypto_md_algo alg, void *data_ptr,
 #endif /* CRYPTO_SUPPORT == CRYPTO_HASH_CALC_ONLY || \
 	  CRYPTO_SUPPORT == CRYPTO_AUTH_VERIFY_AND_HASH_CALC */
 
+/*
+ * Start an incremental hash calculation
+ *
+ * Parameters:
+ *
+ *   ctx: hash context to initialise
+ *   md_alg: message digest algorithm
+ *
+ * Returns CRYPTO_ERR_HASH if the library has no incremental hash support.
+ */
+int crypto_mod_hash_init(crypto_hash_ctx_t *ctx, enum crypto_md_algo md_alg)
+{
+	assert(ctx != NULL);
+
+	if (crypto_lib_desc.hash_init == NULL) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	ctx->md_alg = md_alg;
+
+	return crypto_lib_desc.hash_init(ctx, md_alg);
+}
+
+/*
+ * Add data to an incremental hash calculation
+ *
+ * Parameters:
+ *
+ *   ctx: hash context started by crypto_mod_hash_init()
+ *   data_ptr, data_len: data to be hashed
+ */
+int crypto_mod_hash_update(crypto_hash_ctx_t *ctx, const void *data_ptr,
+			   size_t data_len)
+{
+	assert(ctx != NULL);
+	assert((data_ptr != NULL) || (data_len == 0U));
+	assert(crypto_lib_desc.hash_update != NULL);
+
+	return crypto_lib_desc.hash_update(ctx, data_ptr, data_len);
+}
+
+/*
+ * Complete an incremental hash calculation and release its context
+ *
+ * Parameters:
+ *
+ *   ctx: hash context started by crypto_mod_hash_init()
+ *   output: resulting hash
+ */
+int crypto_mod_hash_final(crypto_hash_ctx_t *ctx,
+			  unsigned char output[CRYPTO_MD_MAX_SIZE])
+{
+	assert(ctx != NULL);
+	assert(output != NULL);
+	assert(crypto_lib_desc.hash_final != NULL);
+
+	return crypto_lib_desc.hash_final(ctx, output);
+}
+
+/*
+ * Get the algorithm and hash value held in a DigestInfo
+ *
+ * Parameters:
+ *
+ *   digest_info_ptr, digest_info_len: DER encoded DigestInfo
+ *   md_alg: message digest algorithm
+ *   hash_ptr, hash_len: hash value, pointing into the DigestInfo
+ */
+int crypto_mod_get_digest_info(void *digest_info_ptr,
+			       unsigned int digest_info_len,
+			       enum crypto_md_algo *md_alg,
+			       void **hash_ptr, unsigned int *hash_len)
+{
+	assert(digest_info_ptr != NULL);
+	assert(digest_info_len != 0U);
+	assert(md_alg != NULL);
+	assert(hash_ptr != NULL);
+	assert(hash_len != NULL);
+
+	if (crypto_lib_desc.get_digest_info == NULL) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	return crypto_lib_desc.get_digest_info(digest_info_ptr,
+					       digest_info_len, md_alg,
+					       hash_ptr, hash_len);
+}
+
+/*
+ * Record the hash of some data for crypto_mod_get_recorded_hash(). The data
+ * must not be modified until crypto_mod_clear_recorded_hashes() is called.
+ * A hash is silently dropped if there is no room left to record it.
+ *
+ * Parameters:
+ *
+ *   alg: message digest algorithm
+ *   data_ptr, data_len: data that was hashed
+ *   hash: hash of the data
+ */
+void crypto_mod_record_hash(enum crypto_md_algo alg, const void *data_ptr,
+			    unsigned int data_len,
+			    const unsigned char hash[CRYPTO_MD_MAX_SIZE])
+{
+	unsigned int i;
+
+	assert(hash != NULL);
+
+	for (i = 0U; i < CRYPTO_HASH_RECORD_NUM; i++) {
+		if (!hash_records[i].valid) {
+			hash_records[i].data_ptr = data_ptr;
+			hash_records[i].data_len = data_len;
+			hash_records[i].alg = alg;
+			(void)memcpy(hash_records[i].hash, hash,
+				     CRYPTO_MD_MAX_SIZE);
+			hash_records[i].valid = true;
+			return;
+		}
+	}
+}
+
+/*
+ * Get a hash recorded by crypto_mod_record_hash()
+ *
+ * Parameters:
+ *
+ *   alg: message digest algorithm
+ *   data_ptr, data_len: data that was hashed
+ *   output: recorded hash
+ *
+ * Returns 0 if a hash was found, 1 otherwise.
+ */
+int crypto_mod_get_recorded_hash(enum crypto_md_algo alg,
+				 const void *data_ptr, unsigned int data_len,
+				 unsigned char output[CRYPTO_MD_MAX_SIZE])
+{
+	unsigned int i;
+
+	assert(output != NULL);
+
+	for (i = 0U; i < CRYPTO_HASH_RECORD_NUM; i++) {
+		if (hash_records[i].valid && (hash_records[i].alg == alg) &&
+		    (hash_records[i].data_ptr == data_ptr) &&
+		    (hash_records[i].data_len == data_len)) {
+			(void)memcpy(output, hash_records[i].hash,
+				     CRYPTO_MD_MAX_SIZE);
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+/*
+ * Forget all the hashes recorded by crypto_mod_record_hash()
+ */
+void crypto_mod_clear_recorded_hashes(void)
+{
+	unsigned int i;
+
+	for (i = 0U; i < CRYPTO_HASH_RECORD_NUM; i++) {
+		hash_records[i].valid = false;
+	}
+}
+
 int crypto_mod_convert_pk(void *full_pk_ptr, unsigned int full_pk_len,
 			  void **hashed_pk_ptr, unsigned int *hashed_pk_len)
 {
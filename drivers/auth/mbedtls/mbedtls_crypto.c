@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2024, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -37,6 +37,10 @@ CASSERT(CRYPTO_MD_MAX_SIZE >= MBEDTLS_MD_MAX_SIZE,
 #endif /* CRYPTO_SUPPORT == CRYPTO_HASH_CALC_ONLY || \
 	  CRYPTO_SUPPORT == CRYPTO_AUTH_VERIFY_AND_HASH_CALC */
 
+CASSERT(sizeof(mbedtls_md_context_t) <=
+	sizeof(((crypto_hash_ctx_t *)NULL)->lib_ctx),
+	assert_mbedtls_md_context_size_overflow);
+
 /*
  * AlgorithmIdentifier  ::=  SEQUENCE  {
  *     algorithm               OBJECT IDENTIFIER,
@@ -63,6 +67,185 @@ static void init(void)
 	mbedtls_init();
 }
 
+/*
+ * Map a generic crypto message digest algorithm to the corresponding macro used
+ * by Mbed TLS.
+ */
+static inline mbedtls_md_type_t md_type(enum crypto_md_algo algo)
+{
+	switch (algo) {
+	case CRYPTO_MD_SHA512:
+		return MBEDTLS_MD_SHA512;
+	case CRYPTO_MD_SHA384:
+		return MBEDTLS_MD_SHA384;
+	case CRYPTO_MD_SHA256:
+		return MBEDTLS_MD_SHA256;
+	default:
+		/* Invalid hash algorithm. */
+		return MBEDTLS_MD_NONE;
+	}
+}
+
+/*
+ * Map a Mbed TLS message digest type back to the generic crypto algorithm.
+ */
+static int md_algo(mbedtls_md_type_t type, enum crypto_md_algo *algo)
+{
+	switch (type) {
+	case MBEDTLS_MD_SHA512:
+		*algo = CRYPTO_MD_SHA512;
+		return 0;
+	case MBEDTLS_MD_SHA384:
+		*algo = CRYPTO_MD_SHA384;
+		return 0;
+	case MBEDTLS_MD_SHA256:
+		*algo = CRYPTO_MD_SHA256;
+		return 0;
+	default:
+		return -1;
+	}
+}
+
+/*
+ * Parse a DigestInfo, returning the digest algorithm and a pointer to the
+ * hash value it holds.
+ */
+static int parse_digest_info(void *digest_info_ptr,
+			     unsigned int digest_info_len,
+			     const mbedtls_md_info_t **md_info,
+			     unsigned char **hash)
+{
+	mbedtls_asn1_buf hash_oid, params;
+	mbedtls_md_type_t md_alg;
+	unsigned char *p, *end;
+	size_t len;
+	int rc;
+
+	/*
+	 * Digest info should be an MBEDTLS_ASN1_SEQUENCE, but padding after
+	 * it is allowed.  This is necessary to support multiple hash
+	 * algorithms.
+	 */
+	p = (unsigned char *)digest_info_ptr;
+	end = p + digest_info_len;
+	rc = mbedtls_asn1_get_tag(&p, end, &len, MBEDTLS_ASN1_CONSTRUCTED |
+				  MBEDTLS_ASN1_SEQUENCE);
+	if (rc != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	end = p + len;
+
+	/* Get the hash algorithm */
+	rc = mbedtls_asn1_get_alg(&p, end, &hash_oid, &params);
+	if (rc != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	rc = mbedtls_oid_get_md_alg(&hash_oid, &md_alg);
+	if (rc != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	*md_info = mbedtls_md_info_from_type(md_alg);
+	if (*md_info == NULL) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	/* Hash should be octet string type and consume all bytes */
+	rc = mbedtls_asn1_get_tag(&p, end, &len, MBEDTLS_ASN1_OCTET_STRING);
+	if ((rc != 0) || ((size_t)(end - p) != len)) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	/* Length of hash must match the algorithm's size */
+	if (len != mbedtls_md_get_size(*md_info)) {
+		return CRYPTO_ERR_HASH;
+	}
+	*hash = p;
+
+	return CRYPTO_SUCCESS;
+}
+
+/*
+ * Return the algorithm and hash value of a DigestInfo
+ */
+static int get_digest_info(void *digest_info_ptr, unsigned int digest_info_len,
+			   enum crypto_md_algo *md_alg, void **hash_ptr,
+			   unsigned int *hash_len)
+{
+	const mbedtls_md_info_t *md_info;
+	unsigned char *hash;
+	int rc;
+
+	rc = parse_digest_info(digest_info_ptr, digest_info_len, &md_info,
+			       &hash);
+	if (rc != CRYPTO_SUCCESS) {
+		return rc;
+	}
+
+	if (md_algo(mbedtls_md_get_type(md_info), md_alg) != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	*hash_ptr = hash;
+	*hash_len = mbedtls_md_get_size(md_info);
+
+	return CRYPTO_SUCCESS;
+}
+
+/*
+ * Incremental hash calculation. The Mbed TLS message digest context lives in
+ * the caller's crypto_hash_ctx_t and allocates its state from the Mbed TLS
+ * heap, which hash_final() gives back.
+ */
+static int hash_init(crypto_hash_ctx_t *ctx, enum crypto_md_algo md_algo)
+{
+	mbedtls_md_context_t *md_ctx = (mbedtls_md_context_t *)ctx->lib_ctx;
+	const mbedtls_md_info_t *md_info;
+
+	md_info = mbedtls_md_info_from_type(md_type(md_algo));
+	if (md_info == NULL) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	mbedtls_md_init(md_ctx);
+	if ((mbedtls_md_setup(md_ctx, md_info, 0) != 0) ||
+	    (mbedtls_md_starts(md_ctx) != 0)) {
+		mbedtls_md_free(md_ctx);
+		return CRYPTO_ERR_HASH;
+	}
+
+	return CRYPTO_SUCCESS;
+}
+
+static int hash_update(crypto_hash_ctx_t *ctx, const void *data_ptr,
+		       size_t data_len)
+{
+	mbedtls_md_context_t *md_ctx = (mbedtls_md_context_t *)ctx->lib_ctx;
+
+	if (mbedtls_md_update(md_ctx, data_ptr, data_len) != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	return CRYPTO_SUCCESS;
+}
+
+static int hash_final(crypto_hash_ctx_t *ctx,
+		      unsigned char output[CRYPTO_MD_MAX_SIZE])
+{
+	mbedtls_md_context_t *md_ctx = (mbedtls_md_context_t *)ctx->lib_ctx;
+	int rc;
+
+	rc = mbedtls_md_finish(md_ctx, output);
+	mbedtls_md_free(md_ctx);
+	if (rc != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	return CRYPTO_SUCCESS;
+}
+
 #if CRYPTO_SUPPORT == CRYPTO_AUTH_VERIFY_ONLY || \
 CRYPTO_SUPPORT == CRYPTO_AUTH_VERIFY_AND_HASH_CALC
 
@@ -175,57 +358,17 @@ end2:
 static int verify_hash(void *data_ptr, unsigned int data_len,
 		       void *digest_info_ptr, unsigned int digest_info_len)
 {
-	mbedtls_asn1_buf hash_oid, params;
-	mbedtls_md_type_t md_alg;
 	const mbedtls_md_info_t *md_info;
-	unsigned char *p, *end, *hash;
+	unsigned char *p, *hash;
 	unsigned char data_hash[MBEDTLS_MD_MAX_SIZE];
-	size_t len;
 	int rc;
 
-	/*
-	 * Digest info should be an MBEDTLS_ASN1_SEQUENCE, but padding after
-	 * it is allowed.  This is necessary to support multiple hash
-	 * algorithms.
-	 */
-	p = (unsigned char *)digest_info_ptr;
-	end = p + digest_info_len;
-	rc = mbedtls_asn1_get_tag(&p, end, &len, MBEDTLS_ASN1_CONSTRUCTED |
-				  MBEDTLS_ASN1_SEQUENCE);
-	if (rc != 0) {
-		return CRYPTO_ERR_HASH;
-	}
-
-	end = p + len;
-
-	/* Get the hash algorithm */
-	rc = mbedtls_asn1_get_alg(&p, end, &hash_oid, &params);
-	if (rc != 0) {
-		return CRYPTO_ERR_HASH;
-	}
-
-	rc = mbedtls_oid_get_md_alg(&hash_oid, &md_alg);
-	if (rc != 0) {
-		return CRYPTO_ERR_HASH;
-	}
-
-	md_info = mbedtls_md_info_from_type(md_alg);
-	if (md_info == NULL) {
-		return CRYPTO_ERR_HASH;
-	}
-
-	/* Hash should be octet string type and consume all bytes */
-	rc = mbedtls_asn1_get_tag(&p, end, &len, MBEDTLS_ASN1_OCTET_STRING);
-	if ((rc != 0) || ((size_t)(end - p) != len)) {
-		return CRYPTO_ERR_HASH;
+	rc = parse_digest_info(digest_info_ptr, digest_info_len, &md_info,
+			       &hash);
+	if (rc != CRYPTO_SUCCESS) {
+		return rc;
 	}
 
-	/* Length of hash must match the algorithm's size */
-	if (len != mbedtls_md_get_size(md_info)) {
-		return CRYPTO_ERR_HASH;
-	}
-	hash = p;
-
 	/* Calculate the hash of the data */
 	p = (unsigned char *)data_ptr;
 	rc = mbedtls_md(md_info, p, data_len, data_hash);
@@ -246,25 +389,6 @@ static int verify_hash(void *data_ptr, unsigned int data_len,
 
 #if CRYPTO_SUPPORT == CRYPTO_HASH_CALC_ONLY || \
 CRYPTO_SUPPORT == CRYPTO_AUTH_VERIFY_AND_HASH_CALC
-/*
- * Map a generic crypto message digest algorithm to the corresponding macro used
- * by Mbed TLS.
- */
-static inline mbedtls_md_type_t md_type(enum crypto_md_algo algo)
-{
-	switch (algo) {
-	case CRYPTO_MD_SHA512:
-		return MBEDTLS_MD_SHA512;
-	case CRYPTO_MD_SHA384:
-		return MBEDTLS_MD_SHA384;
-	case CRYPTO_MD_SHA256:
-		return MBEDTLS_MD_SHA256;
-	default:
-		/* Invalid hash algorithm. */
-		return MBEDTLS_MD_NONE;
-	}
-}
-
 /*
  * Calculate a hash
  *
@@ -410,20 +534,26 @@ static int auth_decrypt(enum crypto_dec_algo dec_algo, void *data_ptr,
  */
 #if CRYPTO_SUPPORT == CRYPTO_AUTH_VERIFY_AND_HASH_CALC
 #if TF_MBEDTLS_USE_AES_GCM
-REGISTER_CRYPTO_LIB(LIB_NAME, init, verify_signature, verify_hash, calc_hash,
-		    auth_decrypt, NULL);
+REGISTER_CRYPTO_LIB_HASH_OPS(LIB_NAME, init, verify_signature, verify_hash,
+			     calc_hash, auth_decrypt, NULL, hash_init,
+			     hash_update, hash_final, get_digest_info);
 #else
-REGISTER_CRYPTO_LIB(LIB_NAME, init, verify_signature, verify_hash, calc_hash,
-		    NULL, NULL);
+REGISTER_CRYPTO_LIB_HASH_OPS(LIB_NAME, init, verify_signature, verify_hash,
+			     calc_hash, NULL, NULL, hash_init, hash_update,
+			     hash_final, get_digest_info);
 #endif
 #elif CRYPTO_SUPPORT == CRYPTO_AUTH_VERIFY_ONLY
 #if TF_MBEDTLS_USE_AES_GCM
-REGISTER_CRYPTO_LIB(LIB_NAME, init, verify_signature, verify_hash, NULL,
-		    auth_decrypt, NULL);
+REGISTER_CRYPTO_LIB_HASH_OPS(LIB_NAME, init, verify_signature, verify_hash,
+			     NULL, auth_decrypt, NULL, hash_init, hash_update,
+			     hash_final, get_digest_info);
 #else
-REGISTER_CRYPTO_LIB(LIB_NAME, init, verify_signature, verify_hash, NULL,
-		    NULL, NULL);
+REGISTER_CRYPTO_LIB_HASH_OPS(LIB_NAME, init, verify_signature, verify_hash,
+			     NULL, NULL, NULL, hash_init, hash_update,
+			     hash_final, get_digest_info);
 #endif
 #elif CRYPTO_SUPPORT == CRYPTO_HASH_CALC_ONLY
-REGISTER_CRYPTO_LIB(LIB_NAME, init, NULL, NULL, calc_hash, NULL, NULL);
+REGISTER_CRYPTO_LIB_HASH_OPS(LIB_NAME, init, NULL, NULL, calc_hash, NULL,
+			     NULL, hash_init, hash_update, hash_final,
+			     get_digest_info);
 #endif /* CRYPTO_SUPPORT == CRYPTO_AUTH_VERIFY_AND_HASH_CALC */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023-2024, Arm Limited. All rights reserved.
+ * Copyright (c) 2023-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -50,6 +50,10 @@ CASSERT(CRYPTO_MD_MAX_SIZE >= MBEDTLS_MD_MAX_SIZE,
 	* CRYPTO_SUPPORT == CRYPTO_AUTH_VERIFY_AND_HASH_CALC
 	*/
 
+CASSERT(sizeof(psa_hash_operation_t) <=
+	sizeof(((crypto_hash_ctx_t *)NULL)->lib_ctx),
+	assert_psa_hash_operation_size_overflow);
+
 /*
  * AlgorithmIdentifier  ::=  SEQUENCE  {
  *     algorithm               OBJECT IDENTIFIER,
@@ -101,6 +105,176 @@ static void init(void)
 	INFO("PSA crypto initialized successfully!\n");
 }
 
+/*
+ * Map a generic crypto message digest algorithm to the corresponding macro used
+ * by Mbed TLS.
+ */
+static inline mbedtls_md_type_t md_type(enum crypto_md_algo algo)
+{
+	switch (algo) {
+	case CRYPTO_MD_SHA512:
+		return MBEDTLS_MD_SHA512;
+	case CRYPTO_MD_SHA384:
+		return MBEDTLS_MD_SHA384;
+	case CRYPTO_MD_SHA256:
+		return MBEDTLS_MD_SHA256;
+	default:
+		/* Invalid hash algorithm. */
+		return MBEDTLS_MD_NONE;
+	}
+}
+
+/*
+ * Map a Mbed TLS message digest type back to the generic crypto algorithm.
+ */
+static int md_algo(mbedtls_md_type_t type, enum crypto_md_algo *algo)
+{
+	switch (type) {
+	case MBEDTLS_MD_SHA512:
+		*algo = CRYPTO_MD_SHA512;
+		return 0;
+	case MBEDTLS_MD_SHA384:
+		*algo = CRYPTO_MD_SHA384;
+		return 0;
+	case MBEDTLS_MD_SHA256:
+		*algo = CRYPTO_MD_SHA256;
+		return 0;
+	default:
+		return -1;
+	}
+}
+
+/*
+ * Parse a DigestInfo, returning the digest algorithm and a pointer to the
+ * hash value it holds.
+ */
+static int parse_digest_info(void *digest_info_ptr,
+			     unsigned int digest_info_len,
+			     mbedtls_md_type_t *md_alg, unsigned char **hash,
+			     size_t *hash_len)
+{
+	mbedtls_asn1_buf hash_oid, params;
+	unsigned char *p, *end;
+	size_t len;
+	int rc;
+
+	/*
+	 * Digest info should be an MBEDTLS_ASN1_SEQUENCE, but padding after
+	 * it is allowed.  This is necessary to support multiple hash
+	 * algorithms.
+	 */
+	p = (unsigned char *)digest_info_ptr;
+	end = p + digest_info_len;
+	rc = mbedtls_asn1_get_tag(&p, end, &len, MBEDTLS_ASN1_CONSTRUCTED |
+				  MBEDTLS_ASN1_SEQUENCE);
+	if (rc != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	end = p + len;
+
+	/* Get the hash algorithm */
+	rc = mbedtls_asn1_get_alg(&p, end, &hash_oid, &params);
+	if (rc != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	/* Hash should be octet string type and consume all bytes */
+	rc = mbedtls_asn1_get_tag(&p, end, &len, MBEDTLS_ASN1_OCTET_STRING);
+	if ((rc != 0) || ((size_t)(end - p) != len)) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	rc = mbedtls_oid_get_md_alg(&hash_oid, md_alg);
+	if (rc != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	/* Length of hash must match the algorithm's size */
+	if (len != PSA_HASH_LENGTH(mbedtls_md_psa_alg_from_type(*md_alg))) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	*hash = p;
+	*hash_len = len;
+
+	return CRYPTO_SUCCESS;
+}
+
+/*
+ * Return the algorithm and hash value of a DigestInfo
+ */
+static int get_digest_info(void *digest_info_ptr, unsigned int digest_info_len,
+			   enum crypto_md_algo *md_alg, void **hash_ptr,
+			   unsigned int *hash_len)
+{
+	mbedtls_md_type_t type;
+	unsigned char *hash;
+	size_t len;
+	int rc;
+
+	rc = parse_digest_info(digest_info_ptr, digest_info_len, &type, &hash,
+			       &len);
+	if (rc != CRYPTO_SUCCESS) {
+		return rc;
+	}
+
+	if (md_algo(type, md_alg) != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	*hash_ptr = hash;
+	*hash_len = (unsigned int)len;
+
+	return CRYPTO_SUCCESS;
+}
+
+/*
+ * Incremental hash calculation. The PSA hash operation lives in the caller's
+ * crypto_hash_ctx_t, hash_final() always leaves it inactive.
+ */
+static int hash_init(crypto_hash_ctx_t *ctx, enum crypto_md_algo md_algo)
+{
+	psa_hash_operation_t *operation = (psa_hash_operation_t *)ctx->lib_ctx;
+	psa_algorithm_t psa_md_alg;
+
+	psa_md_alg = mbedtls_md_psa_alg_from_type(md_type(md_algo));
+
+	*operation = psa_hash_operation_init();
+	if (psa_hash_setup(operation, psa_md_alg) != PSA_SUCCESS) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	return CRYPTO_SUCCESS;
+}
+
+static int hash_update(crypto_hash_ctx_t *ctx, const void *data_ptr,
+		       size_t data_len)
+{
+	psa_hash_operation_t *operation = (psa_hash_operation_t *)ctx->lib_ctx;
+
+	if (psa_hash_update(operation, data_ptr, data_len) != PSA_SUCCESS) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	return CRYPTO_SUCCESS;
+}
+
+static int hash_final(crypto_hash_ctx_t *ctx,
+		      unsigned char output[CRYPTO_MD_MAX_SIZE])
+{
+	psa_hash_operation_t *operation = (psa_hash_operation_t *)ctx->lib_ctx;
+	size_t hash_length;
+
+	if (psa_hash_finish(operation, (uint8_t *)output, CRYPTO_MD_MAX_SIZE,
+			    &hash_length) != PSA_SUCCESS) {
+		(void)psa_hash_abort(operation);
+		return CRYPTO_ERR_HASH;
+	}
+
+	return CRYPTO_SUCCESS;
+}
+
 #if CRYPTO_SUPPORT == CRYPTO_AUTH_VERIFY_ONLY || \
 CRYPTO_SUPPORT == CRYPTO_AUTH_VERIFY_AND_HASH_CALC
 
@@ -497,55 +671,22 @@ end2:
 static int verify_hash(void *data_ptr, unsigned int data_len,
 		       void *digest_info_ptr, unsigned int digest_info_len)
 {
-	mbedtls_asn1_buf hash_oid, params;
 	mbedtls_md_type_t md_alg;
-	unsigned char *p, *end, *hash;
+	unsigned char *hash;
 	size_t len;
 	int rc;
 	psa_status_t status;
 	psa_algorithm_t psa_md_alg;
 
-	/*
-	 * Digest info should be an MBEDTLS_ASN1_SEQUENCE, but padding after
-	 * it is allowed.  This is necessary to support multiple hash
-	 * algorithms.
-	 */
-	p = (unsigned char *)digest_info_ptr;
-	end = p + digest_info_len;
-	rc = mbedtls_asn1_get_tag(&p, end, &len, MBEDTLS_ASN1_CONSTRUCTED |
-				  MBEDTLS_ASN1_SEQUENCE);
-	if (rc != 0) {
-		return CRYPTO_ERR_HASH;
-	}
-
-	end = p + len;
-
-	/* Get the hash algorithm */
-	rc = mbedtls_asn1_get_alg(&p, end, &hash_oid, &params);
-	if (rc != 0) {
-		return CRYPTO_ERR_HASH;
-	}
-
-	/* Hash should be octet string type and consume all bytes */
-	rc = mbedtls_asn1_get_tag(&p, end, &len, MBEDTLS_ASN1_OCTET_STRING);
-	if ((rc != 0) || ((size_t)(end - p) != len)) {
-		return CRYPTO_ERR_HASH;
-	}
-	hash = p;
-
-	rc = mbedtls_oid_get_md_alg(&hash_oid, &md_alg);
-	if (rc != 0) {
-		return CRYPTO_ERR_HASH;
+	rc = parse_digest_info(digest_info_ptr, digest_info_len, &md_alg, &hash,
+			       &len);
+	if (rc != CRYPTO_SUCCESS) {
+		return rc;
 	}
 
 	/* convert the md_alg to psa_algo */
 	psa_md_alg = mbedtls_md_psa_alg_from_type(md_alg);
 
-	/* Length of hash must match the algorithm's size */
-	if (len != PSA_HASH_LENGTH(psa_md_alg)) {
-		return CRYPTO_ERR_HASH;
-	}
-
 	/*
 	 * Calculate Hash and compare it against the retrieved hash from
 	 * the certificate (one shot API).
@@ -567,25 +708,6 @@ static int verify_hash(void *data_ptr, unsigned int data_len,
 
 #if CRYPTO_SUPPORT == CRYPTO_HASH_CALC_ONLY || \
 CRYPTO_SUPPORT == CRYPTO_AUTH_VERIFY_AND_HASH_CALC
-/*
- * Map a generic crypto message digest algorithm to the corresponding macro used
- * by Mbed TLS.
- */
-static inline mbedtls_md_type_t md_type(enum crypto_md_algo algo)
-{
-	switch (algo) {
-	case CRYPTO_MD_SHA512:
-		return MBEDTLS_MD_SHA512;
-	case CRYPTO_MD_SHA384:
-		return MBEDTLS_MD_SHA384;
-	case CRYPTO_MD_SHA256:
-		return MBEDTLS_MD_SHA256;
-	default:
-		/* Invalid hash algorithm. */
-		return MBEDTLS_MD_NONE;
-	}
-}
-
 /*
  * Calculate a hash
  *
@@ -740,20 +862,26 @@ static int auth_decrypt(enum crypto_dec_algo dec_algo, void *data_ptr,
  */
 #if CRYPTO_SUPPORT == CRYPTO_AUTH_VERIFY_AND_HASH_CALC
 #if TF_MBEDTLS_USE_AES_GCM
-REGISTER_CRYPTO_LIB(LIB_NAME, init, verify_signature, verify_hash, calc_hash,
-		    auth_decrypt, NULL);
+REGISTER_CRYPTO_LIB_HASH_OPS(LIB_NAME, init, verify_signature, verify_hash,
+			     calc_hash, auth_decrypt, NULL, hash_init,
+			     hash_update, hash_final, get_digest_info);
 #else
-REGISTER_CRYPTO_LIB(LIB_NAME, init, verify_signature, verify_hash, calc_hash,
-		    NULL, NULL);
+REGISTER_CRYPTO_LIB_HASH_OPS(LIB_NAME, init, verify_signature, verify_hash,
+			     calc_hash, NULL, NULL, hash_init, hash_update,
+			     hash_final, get_digest_info);
 #endif
 #elif CRYPTO_SUPPORT == CRYPTO_AUTH_VERIFY_ONLY
 #if TF_MBEDTLS_USE_AES_GCM
-REGISTER_CRYPTO_LIB(LIB_NAME, init, verify_signature, verify_hash, NULL,
-		    auth_decrypt, NULL);
+REGISTER_CRYPTO_LIB_HASH_OPS(LIB_NAME, init, verify_signature, verify_hash,
+			     NULL, auth_decrypt, NULL, hash_init, hash_update,
+			     hash_final, get_digest_info);
 #else
-REGISTER_CRYPTO_LIB(LIB_NAME, init, verify_signature, verify_hash, NULL,
-		    NULL, NULL);
+REGISTER_CRYPTO_LIB_HASH_OPS(LIB_NAME, init, verify_signature, verify_hash,
+			     NULL, NULL, NULL, hash_init, hash_update,
+			     hash_final, get_digest_info);
 #endif
 #elif CRYPTO_SUPPORT == CRYPTO_HASH_CALC_ONLY
-REGISTER_CRYPTO_LIB(LIB_NAME, init, NULL, NULL, calc_hash, NULL, NULL);
+REGISTER_CRYPTO_LIB_HASH_OPS(LIB_NAME, init, NULL, NULL, calc_hash, NULL,
+			     NULL, hash_init, hash_update, hash_final,
+			     get_digest_info);
 #endif /* CRYPTO_SUPPORT == CRYPTO_AUTH_VERIFY_AND_HASH_CALC */
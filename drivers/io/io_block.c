@@ -1,11 +1,12 @@
 /*
- * Copyright (c) 2016-2023, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2026, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
 #include <errno.h>
+#include <stdbool.h>
 #include <string.h>
 
 #include <platform_def.h>
@@ -240,7 +241,21 @@ static int block_seek(io_entity_t *entity, int mode, signed long long offset)
  *
  * Additionally, the IO driver has an underlying buffer that is at least
  * one block-size and may be big enough to allow.
+ *
+ * If the device allows it (direct_read_align is set), whole blocks are
+ * read straight into the caller's buffer whenever file_pos is block-aligned
+ * and the destination meets the required alignment, so only the partial
+ * head and tail blocks of a request go through the underlying buffer. Each
+ * of these direct reads is limited to max_direct_read, or to the length of
+ * the underlying buffer if it is not set.
  */
+static inline bool is_direct_read_allowed(const io_block_dev_spec_t *dev_spec,
+					  uintptr_t buffer)
+{
+	return (dev_spec->direct_read_align != 0U) &&
+	       ((buffer & (dev_spec->direct_read_align - 1U)) == 0U);
+}
+
 static int block_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 		      size_t *length_read)
 {
@@ -296,6 +311,30 @@ static int block_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 		 */
 		lba = (cur->file_pos + cur->base) / block_size;
 
+		if ((skip == 0U) && (left >= block_size) &&
+		    is_direct_read_allowed(cur->dev_spec, buffer + count)) {
+			/*
+			 * Read as many of the remaining whole blocks as the
+			 * driver takes at once straight into the user buffer,
+			 * without bouncing them.
+			 */
+			request = left & ~(block_size - 1U);
+			if (cur->dev_spec->max_direct_read != 0U) {
+				request = MIN(request,
+					      cur->dev_spec->max_direct_read);
+			} else {
+				request = MIN(request, buf->length);
+			}
+			nbytes = ops->read(lba, buffer + count, request);
+			if ((nbytes == 0U) || (nbytes > request)) {
+				return -EIO;
+			}
+
+			cur->file_pos += nbytes;
+			count += nbytes;
+			continue;
+		}
+
 		if ((skip + left) > buf->length) {
 			/*
 			 * The underlying read buffer is too small to
@@ -519,6 +558,9 @@ static int block_dev_open(const uintptr_t dev_spec, io_dev_info_t **dev_info)
 	       (is_power_of_2(block_size) != 0U) &&
 	       ((buffer->offset % block_size) == 0U) &&
 	       ((buffer->length % block_size) == 0U));
+	assert((cur->dev_spec->direct_read_align == 0U) ||
+	       (is_power_of_2(cur->dev_spec->direct_read_align) != 0U));
+	assert((cur->dev_spec->max_direct_read % block_size) == 0U);
 
 	*dev_info = info;	/* cast away const */
 	(void)block_size;
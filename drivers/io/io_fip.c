@@ -6,6 +6,8 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <limits.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -25,6 +27,11 @@
 #define MAX_FIP_DEVICES		1
 #endif
 
+/* Number of files that can be open at the same time across all FIP devices */
+#ifndef MAX_FIP_FILES
+#define MAX_FIP_FILES		1
+#endif
+
 /* Useful for printing UUIDs when debugging.*/
 #define PRINT_UUID2(x)								\
 	"%08x-%04hx-%04hx-%02hhx%02hhx-%02hhx%02hhx%02hhx%02hhx%02hhx%02hhx",	\
@@ -36,29 +43,74 @@
 typedef struct {
 	unsigned int file_pos;
 	fip_toc_entry_t entry;
+	/* Backend of the FIP the file was opened from */
+	uintptr_t backend_dev_handle;
+	uintptr_t backend_image_spec;
 } fip_file_state_t;
 
+#if FIP_TOC_INDEX_ENTRIES
+/* ToC entry together with its position in the on-disk ToC */
+typedef struct {
+	fip_toc_entry_t entry;
+	unsigned int toc_pos;
+} fip_toc_index_t;
+#endif
+
 /*
- * Maintain dev_spec per FIP Device
+ * Maintain dev_spec and backend per FIP Device
  * TODO - Add backend handles and file state
  * per FIP device here once backends like io_memmap
  * can support multiple open files
+ *
+ * The ToC of the last FIP validated by fip_dev_init() is kept sorted by UUID
+ * in toc_index[], so that opening a file is a binary search instead of a walk
+ * over the ToC on the backend. The index is tagged with the backend device,
+ * the location of the FIP on it and the FIP header it was read with, and is
+ * only reused while all of them still match.
  */
 typedef struct {
 	uintptr_t dev_spec;
 	uint16_t plat_toc_flag;
+	/* Backend of the FIP, as given by the platform to fip_dev_init() */
+	uintptr_t backend_dev_handle;
+	uintptr_t backend_image_spec;
+#if FIP_TOC_INDEX_ENTRIES
+	bool toc_valid;
+	bool toc_complete;
+	unsigned int toc_num_entries;
+	uintptr_t toc_dev_handle;
+	uintptr_t toc_image_spec;
+	bool toc_block_spec_valid;
+	io_block_spec_t toc_block_spec;
+	fip_toc_header_t toc_header;
+	fip_toc_index_t toc_index[FIP_TOC_INDEX_ENTRIES];
+#endif
 } fip_dev_state_t;
 
 /*
- * Only one file can be open across all FIP device
- * as backends like io_memmap don't support
- * multiple open files. The file state and
- * backend handle should be maintained per FIP device
- * if the same support is available in the backend
+ * File state for each open file, shared across all FIP devices. A slot is
+ * free when its ToC entry offset is zero, as the FIP header lives at offset
+ * zero and no file can start there. Each file keeps the backend of the FIP it
+ * was opened from, so that it is not affected by a later fip_dev_init().
+ */
+static fip_file_state_t fip_file_pool[MAX_FIP_FILES];
+
+/*
+ * Backend handle kept open from the first access until the last file is
+ * closed, so that consecutive reads are one sequential stream on the backend.
+ * Backends like io_memmap don't support multiple open files, so only one is
+ * kept, for the backend device and spec it was opened with: accessing another
+ * backend closes it first. backend_pos caches the backend file position to
+ * skip redundant seeks. It is set to FIP_BACKEND_POS_INVALID whenever the
+ * position is not known for certain, which forces the next access to seek.
  */
-static fip_file_state_t current_fip_file = {0};
-static uintptr_t backend_dev_handle;
-static uintptr_t backend_image_spec;
+#define FIP_BACKEND_POS_INVALID	ULLONG_MAX
+
+static uintptr_t backend_handle_cached;
+static uintptr_t backend_cached_dev_handle;
+static uintptr_t backend_cached_image_spec;
+static unsigned long long backend_pos;
+static unsigned int fip_open_files;
 
 static fip_dev_state_t state_pool[MAX_FIP_DEVICES];
 static io_dev_info_t dev_info_pool[MAX_FIP_DEVICES];
@@ -66,6 +118,9 @@ static io_dev_info_t dev_info_pool[MAX_FIP_DEVICES];
 /* Track number of allocated fip devices */
 static unsigned int fip_dev_count;
 
+/* Number of ToC entry reads from the backend avoided by the ToC index */
+static unsigned int fip_toc_reads_saved;
+
 /* Firmware Image Package driver functions */
 static int fip_dev_open(const uintptr_t dev_spec, io_dev_info_t **dev_info);
 static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
@@ -84,6 +139,13 @@ static inline int compare_uuids(const uuid_t *uuid1, const uuid_t *uuid2)
 	return memcmp(uuid1, uuid2, sizeof(uuid_t));
 }
 
+static inline bool is_null_uuid(const uuid_t *uuid)
+{
+	static const uuid_t uuid_null = { {0} }; /* Double braces for clang */
+
+	return compare_uuids(uuid, &uuid_null) == 0;
+}
+
 
 static inline int is_valid_header(fip_toc_header_t *header)
 {
@@ -181,10 +243,251 @@ static int free_dev_info(io_dev_info_t *dev_info)
 	return result;
 }
 
+/* Close the cached backend handle, if any */
+static void fip_backend_release(void)
+{
+	if (backend_handle_cached != (uintptr_t)NULL) {
+		io_close(backend_handle_cached);
+		backend_handle_cached = (uintptr_t)NULL;
+	}
+	backend_cached_dev_handle = (uintptr_t)NULL;
+	backend_cached_image_spec = (uintptr_t)NULL;
+	backend_pos = FIP_BACKEND_POS_INVALID;
+}
+
+/*
+ * Return the cached backend handle for 'dev_handle' and 'image_spec', opening
+ * the backend if needed
+ */
+static int fip_backend_get(uintptr_t dev_handle, uintptr_t image_spec,
+			   uintptr_t *backend_handle)
+{
+	int result;
+
+	if ((backend_handle_cached != (uintptr_t)NULL) &&
+	    ((backend_cached_dev_handle != dev_handle) ||
+	     (backend_cached_image_spec != image_spec))) {
+		fip_backend_release();
+	}
+
+	if (backend_handle_cached == (uintptr_t)NULL) {
+		result = io_open(dev_handle, image_spec,
+				 &backend_handle_cached);
+		if (result != 0) {
+			backend_handle_cached = (uintptr_t)NULL;
+			return result;
+		}
+		backend_cached_dev_handle = dev_handle;
+		backend_cached_image_spec = image_spec;
+		backend_pos = 0ULL;
+	}
+
+	*backend_handle = backend_handle_cached;
+
+	return 0;
+}
+
+/* Move the cached backend handle to 'offset', unless it is already there */
+static int fip_backend_seek(uintptr_t backend_handle, unsigned long long offset)
+{
+	int result;
+
+	if (offset == backend_pos) {
+		return 0;
+	}
+
+	result = io_seek(backend_handle, IO_SEEK_SET, (signed long long)offset);
+	if (result == 0) {
+		backend_pos = offset;
+	} else {
+		backend_pos = FIP_BACKEND_POS_INVALID;
+	}
+
+	return result;
+}
+
+/* Allocate a file state from the pool and return a pointer to it */
+static fip_file_state_t *allocate_file_state(void)
+{
+	unsigned int index;
+
+	for (index = 0; index < (unsigned int)MAX_FIP_FILES; ++index) {
+		if (fip_file_pool[index].entry.offset_address == 0U) {
+			return &fip_file_pool[index];
+		}
+	}
+
+	return NULL;
+}
+
+#if FIP_TOC_INDEX_ENTRIES
+/*
+ * Memory mapped and block backends locate the FIP with an io_block_spec_t.
+ * Platforms may move the FIP by updating that spec in place, so the index has
+ * to be tagged with its contents rather than with its address. Returns false
+ * for other backends, whose spec cannot be interpreted here.
+ */
+static bool fip_backend_block_spec(const fip_dev_state_t *state,
+				   io_block_spec_t *block_spec)
+{
+	const io_dev_info_t *dev =
+		(const io_dev_info_t *)state->backend_dev_handle;
+	io_type_t type;
+
+	if ((dev == NULL) || (dev->funcs == NULL) ||
+	    (dev->funcs->type == NULL) ||
+	    (state->backend_image_spec == (uintptr_t)NULL)) {
+		return false;
+	}
+
+	type = dev->funcs->type();
+	if ((type != IO_TYPE_MEMMAP) && (type != IO_TYPE_BLOCK)) {
+		return false;
+	}
+
+	*block_spec = *(const io_block_spec_t *)state->backend_image_spec;
+
+	return true;
+}
+
+/*
+ * Check that the ToC index of a FIP device was read from the FIP the backend
+ * currently points at. Without a block spec to compare, the index is trusted
+ * until the next fip_dev_init(), which always rebuilds it in that case.
+ */
+static bool fip_toc_index_matches(const fip_dev_state_t *state)
+{
+	io_block_spec_t block_spec;
+
+	if (!state->toc_valid ||
+	    (state->toc_dev_handle != state->backend_dev_handle) ||
+	    (state->toc_image_spec != state->backend_image_spec)) {
+		return false;
+	}
+
+	if (!state->toc_block_spec_valid) {
+		return true;
+	}
+
+	return fip_backend_block_spec(state, &block_spec) &&
+	       (block_spec.offset == state->toc_block_spec.offset) &&
+	       (block_spec.length == state->toc_block_spec.length);
+}
+
+/*
+ * Read the ToC entries following the FIP header from the backend into the
+ * UUID-sorted index of the FIP device. The backend handle must be positioned
+ * right after the FIP header. Failing to build the index is not fatal, file
+ * lookups then fall back to walking the ToC on the backend.
+ */
+static void fip_toc_index_load(fip_dev_state_t *state,
+			       uintptr_t backend_handle,
+			       const fip_toc_header_t *header)
+{
+	fip_toc_entry_t entry;
+	size_t bytes_read;
+	unsigned int toc_pos;
+	unsigned int i;
+	int result;
+
+	state->toc_valid = false;
+	state->toc_complete = false;
+	state->toc_num_entries = 0U;
+
+	for (toc_pos = 0U; ; toc_pos++) {
+		result = io_read(backend_handle, (uintptr_t)&entry,
+				 sizeof(entry), &bytes_read);
+		if ((result != 0) || (bytes_read != sizeof(entry))) {
+			WARN("Failed to read FIP ToC (%i)\n", result);
+			return;
+		}
+
+		if (is_null_uuid(&entry.uuid)) {
+			state->toc_complete = true;
+			break;
+		}
+
+		if (state->toc_num_entries ==
+		    (unsigned int)FIP_TOC_INDEX_ENTRIES) {
+			VERBOSE("FIP ToC exceeds %u entries, index is partial\n",
+				(unsigned int)FIP_TOC_INDEX_ENTRIES);
+			break;
+		}
+
+		/* Insertion sort, the ToC only holds a handful of entries */
+		i = state->toc_num_entries;
+		while ((i > 0U) &&
+		       (compare_uuids(&state->toc_index[i - 1U].entry.uuid,
+				      &entry.uuid) > 0)) {
+			state->toc_index[i] = state->toc_index[i - 1U];
+			i--;
+		}
+		state->toc_index[i].entry = entry;
+		state->toc_index[i].toc_pos = toc_pos;
+		state->toc_num_entries++;
+	}
+
+	state->toc_dev_handle = state->backend_dev_handle;
+	state->toc_image_spec = state->backend_image_spec;
+	state->toc_block_spec_valid =
+		fip_backend_block_spec(state, &state->toc_block_spec);
+	state->toc_header = *header;
+	state->toc_valid = true;
+}
+
+/*
+ * Look up a file in the ToC index of a FIP device. Returns 0 and fills in
+ * 'entry' if found, -ENOENT if the index covers the whole ToC and the file
+ * is not in it, or -EAGAIN if the ToC has to be walked on the backend.
+ */
+static int fip_toc_index_lookup(const fip_dev_state_t *state,
+				const uuid_t *uuid, fip_toc_entry_t *entry)
+{
+	unsigned int low = 0U;
+	unsigned int high;
+	unsigned int mid;
+	int cmp;
+
+	if (!fip_toc_index_matches(state)) {
+		return -EAGAIN;
+	}
+
+	high = state->toc_num_entries;
+	while (low < high) {
+		mid = low + ((high - low) / 2U);
+		cmp = compare_uuids(&state->toc_index[mid].entry.uuid, uuid);
+		if (cmp == 0) {
+			*entry = state->toc_index[mid].entry;
+			/* A backend walk reads every entry up to this one */
+			fip_toc_reads_saved += state->toc_index[mid].toc_pos + 1U;
+			return 0;
+		} else if (cmp < 0) {
+			low = mid + 1U;
+		} else {
+			high = mid;
+		}
+	}
+
+	if (state->toc_complete) {
+		/* ... or up to and including the terminating null entry */
+		fip_toc_reads_saved += state->toc_num_entries + 1U;
+		return -ENOENT;
+	}
+
+	return -EAGAIN;
+}
+#else
+static int fip_toc_index_lookup(const fip_dev_state_t *state,
+				const uuid_t *uuid, fip_toc_entry_t *entry)
+{
+	return -EAGAIN;
+}
+#endif /* FIP_TOC_INDEX_ENTRIES */
+
 /*
  * Multiple FIP devices can be opened depending on the value of
- * MAX_FIP_DEVICES. Given that there is only one backend, only a
- * single file can be open at a time by any FIP device.
+ * MAX_FIP_DEVICES. Up to MAX_FIP_FILES files can be open at a time
+ * across all FIP devices.
  */
 static int fip_dev_open(const uintptr_t dev_spec,
 			 io_dev_info_t **dev_info)
@@ -226,9 +529,22 @@ static int fip_dev_init(io_dev_info_t *dev_info, const uintptr_t init_params)
 
 	state = (fip_dev_state_t *)dev_info->info;
 
+	/*
+	 * Drop any handle held on the backend. Platforms usually open the
+	 * backend in plat_get_image_source() to check that the image is
+	 * there. Backends such as io_memmap only support one open file and
+	 * would then fail with the handle still held. Files still open keep
+	 * their own backend and get the handle back on their next read. This
+	 * does not cost a reopen in the common case: the handle is only held
+	 * while FIP files are open, and images are loaded one at a time, so it
+	 * has already been released by the time the next image initialises
+	 * the FIP device.
+	 */
+	fip_backend_release();
+
 	/* Obtain a reference to the image by querying the platform layer */
-	result = plat_get_image_source(image_id, &backend_dev_handle,
-				       &backend_image_spec);
+	result = plat_get_image_source(image_id, &state->backend_dev_handle,
+				       &state->backend_image_spec);
 	if (result != 0) {
 		WARN("Failed to obtain reference to image id=%u (%i)\n",
 			image_id, result);
@@ -237,7 +553,7 @@ static int fip_dev_init(io_dev_info_t *dev_info, const uintptr_t init_params)
 	}
 
 	/* Attempt to access the FIP image */
-	result = io_open(backend_dev_handle, backend_image_spec,
+	result = io_open(state->backend_dev_handle, state->backend_image_spec,
 			 &backend_handle);
 	if (result != 0) {
 		WARN("Failed to access image id=%u (%i)\n", image_id, result);
@@ -258,6 +574,17 @@ static int fip_dev_init(io_dev_info_t *dev_info, const uintptr_t init_params)
 			 * bits [32-47] in fip header.
 			 */
 			state->plat_toc_flag = (header.flags >> 32) & 0xffff;
+
+#if FIP_TOC_INDEX_ENTRIES
+			/* Reuse the ToC index if this is still the same FIP */
+			if (!state->toc_block_spec_valid ||
+			    !fip_toc_index_matches(state) ||
+			    (memcmp(&state->toc_header, &header,
+				    sizeof(header)) != 0)) {
+				fip_toc_index_load(state, backend_handle,
+						   &header);
+			}
+#endif
 		}
 	}
 
@@ -273,8 +600,7 @@ static int fip_dev_close(io_dev_info_t *dev_info)
 	/* TODO: Consider tracking open files and cleaning them up here */
 
 	/* Clear the backend. */
-	backend_dev_handle = (uintptr_t)NULL;
-	backend_image_spec = (uintptr_t)NULL;
+	fip_backend_release();
 
 	return free_dev_info(dev_info);
 }
@@ -287,27 +613,48 @@ static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 	int result;
 	uintptr_t backend_handle;
 	const io_uuid_spec_t *uuid_spec = (io_uuid_spec_t *)spec;
-	static const uuid_t uuid_null = { {0} }; /* Double braces for clang */
+	const fip_dev_state_t *state;
+	fip_file_state_t *fp;
 	size_t bytes_read;
 	int found_file = 0;
 
+	assert(dev_info != NULL);
 	assert(uuid_spec != NULL);
 	assert(entity != NULL);
 
-	/* Can only have one file open at a time for the moment. We need to
-	 * track state like file cursor position. We know the header lives at
-	 * offset zero, so this entry should never be zero for an active file.
-	 * When the system supports dynamic memory allocation we can allow more
-	 * than one open file at a time if needed.
+	/* We need to track state like file cursor position per open file.
+	 * The number of files open at a time is bounded by the size of the
+	 * file state pool.
 	 */
-	if (current_fip_file.entry.offset_address != 0U) {
-		WARN("fip_file_open : Only one open file at a time.\n");
+	fp = allocate_file_state();
+	if (fp == NULL) {
+		WARN("fip_file_open : Too many open files (max %u).\n",
+		     (unsigned int)MAX_FIP_FILES);
 		return -ENFILE;
 	}
 
+	/* The file keeps reading from this FIP whatever happens to the device */
+	state = (const fip_dev_state_t *)dev_info->info;
+	fp->backend_dev_handle = state->backend_dev_handle;
+	fp->backend_image_spec = state->backend_image_spec;
+
+	/* Try the ToC index first to avoid walking the ToC on the backend */
+	result = fip_toc_index_lookup(state, &uuid_spec->uuid, &fp->entry);
+	if (result == 0) {
+		VERBOSE("FIP: ToC index hit, %u ToC reads saved so far\n",
+			fip_toc_reads_saved);
+		fp->file_pos = 0;
+		entity->info = (uintptr_t)fp;
+		fip_open_files++;
+		return 0;
+	} else if (result == -ENOENT) {
+		zeromem(fp, sizeof(*fp));
+		return -ENOENT;
+	}
+
 	/* Attempt to access the FIP image */
-	result = io_open(backend_dev_handle, backend_image_spec,
-			 &backend_handle);
+	result = fip_backend_get(fp->backend_dev_handle, fp->backend_image_spec,
+				 &backend_handle);
 	if (result != 0) {
 		WARN("Failed to open Firmware Image Package (%i)\n", result);
 		result = -ENOENT;
@@ -315,8 +662,7 @@ static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 	}
 
 	/* Seek past the FIP header into the Table of Contents */
-	result = io_seek(backend_handle, IO_SEEK_SET,
-			 (signed long long)sizeof(fip_toc_header_t));
+	result = fip_backend_seek(backend_handle, sizeof(fip_toc_header_t));
 	if (result != 0) {
 		WARN("fip_file_open: failed to seek\n");
 		result = -ENOENT;
@@ -326,39 +672,47 @@ static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 	found_file = 0;
 	do {
 		result = io_read(backend_handle,
-				 (uintptr_t)&current_fip_file.entry,
-				 sizeof(current_fip_file.entry),
+				 (uintptr_t)&fp->entry,
+				 sizeof(fp->entry),
 				 &bytes_read);
-		if (result == 0) {
-			if (compare_uuids(&current_fip_file.entry.uuid,
+		if ((result == 0) && (bytes_read == sizeof(fp->entry))) {
+			backend_pos += bytes_read;
+			if (compare_uuids(&fp->entry.uuid,
 					  &uuid_spec->uuid) == 0) {
 				found_file = 1;
 			}
 		} else {
 			WARN("Failed to read FIP (%i)\n", result);
+			backend_pos = FIP_BACKEND_POS_INVALID;
+			result = -ENOENT;
 			goto fip_file_open_close;
 		}
 	} while ((found_file == 0) &&
-			(compare_uuids(&current_fip_file.entry.uuid,
-				&uuid_null) != 0));
+			!is_null_uuid(&fp->entry.uuid));
 
 	if (found_file == 1) {
 		/* All fine. Update entity info with file state and return. Set
-		 * the file position to 0. The 'current_fip_file.entry' holds
-		 * the base and size of the file.
+		 * the file position to 0. The 'fp->entry' holds the base and
+		 * size of the file.
 		 */
-		current_fip_file.file_pos = 0;
-		entity->info = (uintptr_t)&current_fip_file;
-	} else {
-		/* Did not find the file in the FIP. */
-		current_fip_file.entry.offset_address = 0;
-		result = -ENOENT;
+		fp->file_pos = 0;
+		entity->info = (uintptr_t)fp;
+		fip_open_files++;
+		return 0;
 	}
 
+	/* Did not find the file in the FIP. */
+	result = -ENOENT;
+
  fip_file_open_close:
-	io_close(backend_handle);
+	/* Only hold on to the backend while files are open */
+	if (fip_open_files == 0U) {
+		fip_backend_release();
+	}
 
  fip_file_open_exit:
+	/* Release the file state so the slot is not leaked */
+	zeromem(fp, sizeof(*fp));
 	return result;
 }
 
@@ -389,21 +743,23 @@ static int fip_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 	assert(length_read != NULL);
 	assert(entity->info != (uintptr_t)NULL);
 
-	/* Open the backend, attempt to access the blob image */
-	result = io_open(backend_dev_handle, backend_image_spec,
-			 &backend_handle);
+	/*
+	 * Get the backend, opening it on the first read. It stays open until
+	 * the last file is closed, so the seek is skipped whenever this read
+	 * carries on from where the previous one stopped.
+	 */
+	fp = (fip_file_state_t *)entity->info;
+	result = fip_backend_get(fp->backend_dev_handle, fp->backend_image_spec,
+				 &backend_handle);
 	if (result != 0) {
 		WARN("Failed to open FIP (%i)\n", result);
 		result = -ENOENT;
 		goto fip_file_read_exit;
 	}
 
-	fp = (fip_file_state_t *)entity->info;
-
 	/* Seek to the position in the FIP where the payload lives */
 	file_offset = fp->entry.offset_address + fp->file_pos;
-	result = io_seek(backend_handle, IO_SEEK_SET,
-			 (signed long long)file_offset);
+	result = fip_backend_seek(backend_handle, file_offset);
 	if (result != 0) {
 		WARN("fip_file_read: failed to seek\n");
 		result = -ENOENT;
@@ -420,11 +776,19 @@ static int fip_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 		/* Set caller length and new file position. */
 		*length_read = bytes_read;
 		fp->file_pos += bytes_read;
+		/* Don't trust the backend position after a short read */
+		if (bytes_read == length) {
+			backend_pos += bytes_read;
+		} else {
+			backend_pos = FIP_BACKEND_POS_INVALID;
+		}
 	}
 
-/* Close the backend. */
+	return 0;
+
+/* The backend position is unknown after a failure, so drop it. */
  fip_file_read_close:
-	io_close(backend_handle);
+	fip_backend_release();
 
  fip_file_read_exit:
 	return result;
@@ -434,11 +798,23 @@ static int fip_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 /* Close a file in package */
 static int fip_file_close(io_entity_t *entity)
 {
-	/* Clear our current file pointer.
+	fip_file_state_t *fp;
+
+	assert(entity != NULL);
+
+	/* Release the file state back to the pool.
 	 * If we had malloc() we would free() here.
 	 */
-	if (current_fip_file.entry.offset_address != 0U) {
-		zeromem(&current_fip_file, sizeof(current_fip_file));
+	fp = (fip_file_state_t *)entity->info;
+	if (fp != NULL) {
+		zeromem(fp, sizeof(*fp));
+
+		/* Let go of the backend once the last file is closed */
+		assert(fip_open_files > 0U);
+		fip_open_files--;
+		if (fip_open_files == 0U) {
+			fip_backend_release();
+		}
 	}
 
 	/* Clear the Entity info. */
@@ -479,3 +855,12 @@ int fip_dev_get_plat_toc_flag(io_dev_info_t *dev_info, uint16_t *plat_toc_flag)
 
 	return 0;
 }
+
+/*
+ * Close the backend handle held by the FIP driver, e.g. before accessing the
+ * backend directly while FIP files are open. It is reopened on the next read.
+ */
+void fip_dev_invalidate_backend(void)
+{
+	fip_backend_release();
+}
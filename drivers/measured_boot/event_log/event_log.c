@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2020-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -14,16 +14,6 @@
 #include <drivers/auth/crypto_mod.h>
 #include <drivers/measured_boot/event_log/event_log.h>
 
-#if TPM_ALG_ID == TPM_ALG_SHA512
-#define	CRYPTO_MD_ID	CRYPTO_MD_SHA512
-#elif TPM_ALG_ID == TPM_ALG_SHA384
-#define	CRYPTO_MD_ID	CRYPTO_MD_SHA384
-#elif TPM_ALG_ID == TPM_ALG_SHA256
-#define	CRYPTO_MD_ID	CRYPTO_MD_SHA256
-#else
-#  error Invalid TPM algorithm.
-#endif /* TPM_ALG_ID */
-
 /* Running Event Log Pointer */
 static uint8_t *log_ptr;
 
@@ -255,11 +245,41 @@ void event_log_write_header(void)
 int event_log_measure(uintptr_t data_base, uint32_t data_size,
 		      unsigned char hash_data[CRYPTO_MD_MAX_SIZE])
 {
+	/* Use the hash calculated while the image was loaded, if any */
+	if (crypto_mod_get_recorded_hash(EVENT_LOG_MD_ID, (void *)data_base,
+					 data_size, hash_data) == 0) {
+		return 0;
+	}
+
 	/* Calculate hash */
-	return crypto_mod_calc_hash(CRYPTO_MD_ID,
+	return crypto_mod_calc_hash(EVENT_LOG_MD_ID,
 				    (void *)data_base, data_size, hash_data);
 }
 
+/*
+ * Check whether event_log_measure_and_record() measures the data 'data_id',
+ * that is whether it is in the Event Log metadata.
+ *
+ * @param[in] data_id		Data ID
+ * @param[in] metadata_ptr	Event Log metadata
+ * @return:
+ *	true if 'data_id' is in the metadata, false otherwise
+ */
+bool event_log_has_data(uint32_t data_id,
+			const event_log_metadata_t *metadata_ptr)
+{
+	assert(metadata_ptr != NULL);
+
+	while (metadata_ptr->id != EVLOG_INVALID_ID) {
+		if (metadata_ptr->id == data_id) {
+			return true;
+		}
+		metadata_ptr++;
+	}
+
+	return false;
+}
+
 /*
  * Calculate and write hash of image, configuration data, etc.
  * to Event Log.
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef BL2_WORKERS_H
+#define BL2_WORKERS_H
+
+#include <lib/utils_def.h>
+
+#include <platform_def.h>
+
+/* Size of the stack of each secondary CPU running BL2 jobs */
+#ifdef PLAT_BL2_WORKER_STACK_SIZE
+#define BL2_WORKER_STACK_SIZE	PLAT_BL2_WORKER_STACK_SIZE
+#else
+#define BL2_WORKER_STACK_SIZE	U(0x800)
+#endif
+
+#ifndef __ASSEMBLER__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Job run by a secondary CPU while the primary CPU carries on. Its fields are
+ * owned by the worker running it between bl2_workers_submit() and
+ * bl2_workers_wait().
+ */
+typedef struct bl2_job {
+	int (*fn)(void *arg);
+	void *arg;
+	int ret;
+	volatile bool done;
+} bl2_job_t;
+
+#if BL2_WORKERS
+void bl2_workers_start(void);
+void bl2_workers_stop(void);
+unsigned int bl2_workers_available(void);
+void bl2_workers_submit(bl2_job_t *job);
+int bl2_workers_wait(bl2_job_t *job);
+void bl2_workers_zeromem(void *mem, size_t length);
+
+void bl2_worker_entrypoint(void);
+void bl2_worker_setup(void);
+void bl2_worker_main(void);
+#else
+static inline void bl2_workers_start(void)
+{
+}
+static inline void bl2_workers_stop(void)
+{
+}
+#endif /* BL2_WORKERS */
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* BL2_WORKERS_H */
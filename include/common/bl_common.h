@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2026, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -167,10 +167,31 @@ typedef struct meminfo {
 	size_t total_size;
 } meminfo_t;
 
+/*******************************************************************************
+ * Consumer of the data of an image while it is being loaded. Rather than
+ * placing the image at image_base, load_image() then reads it in pieces of up
+ * to 'buf_size' bytes at 'buf_base' and passes each of them to write(). end()
+ * returns in 'size' the size of what the consumer stored at image_base, which
+ * becomes image_size. If the load fails once start() has been called, the
+ * image_max_size bytes at image_base are wiped.
+ *
+ * The consumer would transform the image before it could be authenticated, so
+ * load_auth_image() refuses to stream an image when Trusted Board Boot is
+ * enabled.
+ ******************************************************************************/
+typedef struct image_load_stream {
+	uintptr_t buf_base;
+	size_t buf_size;
+	int (*start)(const image_info_t *image_data);
+	int (*write)(uintptr_t buf, size_t len);
+	int (*end)(const image_info_t *image_data, size_t *size);
+} image_load_stream_t;
+
 /*******************************************************************************
  * Function & variable prototypes
  ******************************************************************************/
 int load_auth_image(unsigned int image_id, image_info_t *image_data);
+void set_image_load_stream(const image_load_stream_t *stream);
 
 #if TRUSTED_BOARD_BOOT && defined(DYN_DISABLE_AUTH)
 /*
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2018-2026, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -16,8 +16,23 @@ typedef int (decompressor_t)(uintptr_t *in_buf, size_t in_len,
 			     uintptr_t *out_buf, size_t out_len,
 			     uintptr_t work_buf, size_t work_len);
 
+/*
+ * Decompressor that is fed the compressed data piece by piece: init() is
+ * called first, then feed() for each piece of input in order and finally end()
+ * which returns the end of the output in 'out_buf'.
+ */
+typedef struct decompressor_stream {
+	int (*init)(uintptr_t out_buf, size_t out_len,
+		    uintptr_t work_buf, size_t work_len);
+	int (*feed)(uintptr_t in_buf, size_t in_len);
+	int (*end)(uintptr_t *out_buf);
+} decompressor_stream_t;
+
 void image_decompress_init(uintptr_t buf_base, uint32_t buf_size,
 			   decompressor_t *decompressor);
+void image_decompress_init_stream(uintptr_t buf_base, uint32_t buf_size,
+				  uintptr_t work_base, uint32_t work_size,
+				  const decompressor_stream_t *decompressor);
 void image_decompress_prepare(struct image_info *info);
 int image_decompress(struct image_info *info);
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -7,6 +7,9 @@
 #ifndef CRYPTO_MOD_H
 #define CRYPTO_MOD_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 #define	CRYPTO_AUTH_VERIFY_ONLY			1
 #define	CRYPTO_HASH_CALC_ONLY			2
 #define	CRYPTO_AUTH_VERIFY_AND_HASH_CALC	3
@@ -39,6 +42,21 @@ enum crypto_md_algo {
 /* Maximum size as per the known stronger hash algorithm i.e.SHA512 */
 #define CRYPTO_MD_MAX_SIZE		64U
 
+/* Number of digests of the same data that crypto_mod_record_hash() keeps */
+#define CRYPTO_HASH_RECORD_NUM		2U
+
+/* Size of the crypto library state kept in an incremental hash context */
+#define CRYPTO_HASH_CTX_SIZE		256U
+
+/*
+ * Incremental hash context. The storage is owned by the caller and its
+ * contents are private to the crypto library.
+ */
+typedef struct crypto_hash_ctx_s {
+	enum crypto_md_algo md_alg;
+	uint64_t lib_ctx[CRYPTO_HASH_CTX_SIZE / sizeof(uint64_t)];
+} crypto_hash_ctx_t;
+
 /*
  * Cryptographic library descriptor
  */
@@ -79,6 +97,26 @@ typedef struct crypto_lib_desc_s {
 			    unsigned int key_flags, const void *iv,
 			    unsigned int iv_len, const void *tag,
 			    unsigned int tag_len);
+
+	/*
+	 * Incremental hash calculation (optional). hash_final() releases the
+	 * context whether it succeeds or not. Return one of the
+	 * 'enum crypto_ret_value' options.
+	 */
+	int (*hash_init)(crypto_hash_ctx_t *ctx, enum crypto_md_algo md_alg);
+	int (*hash_update)(crypto_hash_ctx_t *ctx, const void *data_ptr,
+			   size_t data_len);
+	int (*hash_final)(crypto_hash_ctx_t *ctx,
+			  unsigned char output[CRYPTO_MD_MAX_SIZE]);
+
+	/*
+	 * Extract the algorithm and hash value from a DER encoded DigestInfo
+	 * (optional). Return one of the 'enum crypto_ret_value' options.
+	 */
+	int (*get_digest_info)(void *digest_info_ptr,
+			       unsigned int digest_info_len,
+			       enum crypto_md_algo *md_alg,
+			       void **hash_ptr, unsigned int *hash_len);
 } crypto_lib_desc_t;
 
 /* Public functions */
@@ -118,9 +156,40 @@ int crypto_mod_calc_hash(enum crypto_md_algo alg, void *data_ptr,
 int crypto_mod_convert_pk(void *full_pk_ptr, unsigned int full_pk_len,
 			  void **hashed_pk_ptr, unsigned int *hashed_pk_len);
 
+#if CRYPTO_SUPPORT
+int crypto_mod_hash_init(crypto_hash_ctx_t *ctx, enum crypto_md_algo md_alg);
+int crypto_mod_hash_update(crypto_hash_ctx_t *ctx, const void *data_ptr,
+			   size_t data_len);
+int crypto_mod_hash_final(crypto_hash_ctx_t *ctx,
+			  unsigned char output[CRYPTO_MD_MAX_SIZE]);
+int crypto_mod_get_digest_info(void *digest_info_ptr,
+			       unsigned int digest_info_len,
+			       enum crypto_md_algo *md_alg,
+			       void **hash_ptr, unsigned int *hash_len);
+void crypto_mod_record_hash(enum crypto_md_algo alg, const void *data_ptr,
+			    unsigned int data_len,
+			    const unsigned char hash[CRYPTO_MD_MAX_SIZE]);
+int crypto_mod_get_recorded_hash(enum crypto_md_algo alg,
+				 const void *data_ptr, unsigned int data_len,
+				 unsigned char output[CRYPTO_MD_MAX_SIZE]);
+void crypto_mod_clear_recorded_hashes(void);
+#endif /* CRYPTO_SUPPORT */
+
 /* Macro to register a cryptographic library */
 #define REGISTER_CRYPTO_LIB(_name, _init, _verify_signature, _verify_hash, \
 			    _calc_hash, _auth_decrypt, _convert_pk) \
+	REGISTER_CRYPTO_LIB_HASH_OPS(_name, _init, _verify_signature, \
+				     _verify_hash, _calc_hash, _auth_decrypt, \
+				     _convert_pk, NULL, NULL, NULL, NULL)
+
+/*
+ * Macro to register a cryptographic library that also supports incremental
+ * hash calculation
+ */
+#define REGISTER_CRYPTO_LIB_HASH_OPS(_name, _init, _verify_signature, \
+				     _verify_hash, _calc_hash, _auth_decrypt, \
+				     _convert_pk, _hash_init, _hash_update, \
+				     _hash_final, _get_digest_info) \
 	const crypto_lib_desc_t crypto_lib_desc = { \
 		.name = _name, \
 		.init = _init, \
@@ -128,7 +197,11 @@ int crypto_mod_convert_pk(void *full_pk_ptr, unsigned int full_pk_len,
 		.verify_hash = _verify_hash, \
 		.calc_hash = _calc_hash, \
 		.auth_decrypt = _auth_decrypt, \
-		.convert_pk = _convert_pk \
+		.convert_pk = _convert_pk, \
+		.hash_init = _hash_init, \
+		.hash_update = _hash_update, \
+		.hash_final = _hash_final, \
+		.get_digest_info = _get_digest_info \
 	}
 
 extern const crypto_lib_desc_t crypto_lib_desc;
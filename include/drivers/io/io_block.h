@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2026, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -19,6 +19,19 @@ typedef struct io_block_dev_spec {
 	io_block_spec_t	buffer;
 	io_block_ops_t	ops;
 	size_t		block_size;
+	/*
+	 * Alignment ops.read() requires for a destination buffer other than
+	 * the one above, or zero if ops.read() may only target that buffer.
+	 * When set, the block-aligned part of a read is done straight into the
+	 * caller's buffer if it is suitably aligned.
+	 */
+	size_t		direct_read_align;
+	/*
+	 * Largest read done straight into the caller's buffer, a multiple of
+	 * block_size, or zero to use the length of the buffer above. Drivers
+	 * that size their DMA descriptors for that buffer need it to be zero.
+	 */
+	size_t		max_direct_read;
 } io_block_dev_spec_t;
 
 struct io_dev_connector;
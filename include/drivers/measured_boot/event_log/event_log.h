@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020-2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2020-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -7,6 +7,7 @@
 #ifndef EVENT_LOG_H
 #define EVENT_LOG_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include <common/debug.h>
@@ -36,6 +37,17 @@
 #error "Not supported EVENT_LOG_LEVEL"
 #endif
 
+/* Crypto module algorithm matching the Event Log hash algorithm */
+#if TPM_ALG_ID == TPM_ALG_SHA512
+#define	EVENT_LOG_MD_ID		CRYPTO_MD_SHA512
+#elif TPM_ALG_ID == TPM_ALG_SHA384
+#define	EVENT_LOG_MD_ID		CRYPTO_MD_SHA384
+#elif TPM_ALG_ID == TPM_ALG_SHA256
+#define	EVENT_LOG_MD_ID		CRYPTO_MD_SHA256
+#else
+#  error Invalid TPM algorithm.
+#endif /* TPM_ALG_ID */
+
 /* Number of hashing algorithms supported */
 #define HASH_ALG_COUNT		1U
 
@@ -119,6 +131,8 @@ int event_log_measure(uintptr_t data_base, uint32_t data_size,
 		      unsigned char hash_data[CRYPTO_MD_MAX_SIZE]);
 void event_log_record(const uint8_t *hash, uint32_t event_type,
 		      const event_log_metadata_t *metadata_ptr);
+bool event_log_has_data(uint32_t data_id,
+			const event_log_metadata_t *metadata_ptr);
 int event_log_measure_and_record(uintptr_t data_base, uint32_t data_size,
 				 uint32_t data_id,
 				 const event_log_metadata_t *metadata_ptr);
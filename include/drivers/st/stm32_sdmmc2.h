@@ -12,6 +12,9 @@
 #include <drivers/mmc.h>
 #include <drivers/st/regulator.h>
 
+/* Largest number of whole blocks the data length register (DLENR) can hold */
+#define SDMMC2_MAX_READ_SIZE	(GENMASK_32(24, 0) & ~(MMC_BLOCK_SIZE - 1U))
+
 struct stm32_sdmmc2_params {
 	uintptr_t		reg_base;
 	unsigned int		clk_rate;
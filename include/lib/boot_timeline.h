@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef BOOT_TIMELINE_H
+#define BOOT_TIMELINE_H
+
+#include <stdint.h>
+
+#include <lib/utils_def.h>
+
+/*
+ * Timeline of the phases BL1 and BL2 go through to load each image, published
+ * in the transfer list as a boot_timeline_header followed by 'count' records.
+ * Times are in ticks of the generic counter, at 'cnt_freq' Hz.
+ */
+#define BOOT_TIMELINE_SIGNATURE		U(0x4e4c5442)	/* "BTLN" */
+#define BOOT_TIMELINE_VERSION		U(1)
+
+/* Phases of the loading of an image */
+#define BOOT_PHASE_OPEN			U(0)
+#define BOOT_PHASE_READ			U(1)
+#define BOOT_PHASE_AUTH			U(2)
+#define BOOT_PHASE_MEASURE		U(3)
+#define BOOT_PHASE_DECOMPRESS		U(4)
+
+/* Image ID standing for the image of the previous record */
+#define BOOT_TIMELINE_LAST_IMAGE	U(0xffff)
+
+#ifndef __ASSEMBLER__
+
+struct boot_timeline_header {
+	uint32_t signature;
+	uint16_t version;
+	uint16_t count;		/* Number of records following the header */
+	uint64_t cnt_freq;	/* Frequency of the generic counter in Hz */
+};
+
+struct boot_timeline_record {
+	uint64_t start;		/* Counter value at the start of the phase */
+	uint32_t duration;	/* Counter ticks, saturated to UINT32_MAX */
+	uint16_t image_id;
+	uint8_t phase;		/* BOOT_PHASE_* */
+	uint8_t bl_stage;	/* 1 for BL1, 2 for BL2 */
+};
+
+struct transfer_list_header;
+
+#if ENABLE_BOOT_TIMELINE && (defined(IMAGE_BL1) || defined(IMAGE_BL2))
+void boot_timeline_init(void);
+uint64_t boot_timeline_now(void);
+void boot_timeline_record(unsigned int image_id, unsigned int phase,
+			  uint64_t start);
+int boot_timeline_publish(struct transfer_list_header *tl);
+#else
+static inline void boot_timeline_init(void)
+{
+}
+static inline uint64_t boot_timeline_now(void)
+{
+	return 0U;
+}
+static inline void boot_timeline_record(unsigned int image_id __unused,
+					unsigned int phase __unused,
+					uint64_t start __unused)
+{
+}
+static inline int boot_timeline_publish(
+					struct transfer_list_header *tl __unused)
+{
+	return 0;
+}
+#endif /* ENABLE_BOOT_TIMELINE && (IMAGE_BL1 || IMAGE_BL2) */
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* BOOT_TIMELINE_H */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -48,6 +48,14 @@ void cm_el2_sysregs_context_restore(uint32_t security_state);
 
 void cm_el1_sysregs_context_save(uint32_t security_state);
 void cm_el1_sysregs_context_restore(uint32_t security_state);
+#if CTX_INCLUDE_FPREGS
+void cm_fpregs_context_save(uint32_t security_state);
+void cm_fpregs_context_restore(uint32_t security_state);
+#if CTX_LAZY_FPREGS
+void cm_handle_fpregs_trap(void);
+void cm_fpregs_context_flush(void);
+#endif
+#endif /* CTX_INCLUDE_FPREGS */
 void cm_set_elr_el3(uint32_t security_state, uintptr_t entrypoint);
 void cm_set_elr_spsr_el3(uint32_t security_state,
 			uintptr_t entrypoint, uint32_t spsr);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2014-2021, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2014-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -33,12 +33,21 @@
 /* 8-bytes aligned offset of apiakey[2], size 16 bytes */
 #define	CPU_DATA_APIAKEY_OFFSET		(0x8 + PSCI_CPU_DATA_SIZE_ALIGNED \
 					     + CPU_DATA_CPU_OPS_PTR)
-#define CPU_DATA_CRASH_BUF_OFFSET	(0x10 + CPU_DATA_APIAKEY_OFFSET)
+#define CPU_DATA_PAUTH_END		(0x10 + CPU_DATA_APIAKEY_OFFSET)
 #else /* ENABLE_PAUTH */
-#define CPU_DATA_CRASH_BUF_OFFSET	(0x8 + PSCI_CPU_DATA_SIZE_ALIGNED \
+#define CPU_DATA_PAUTH_END		(0x8 + PSCI_CPU_DATA_SIZE_ALIGNED \
 					     + CPU_DATA_CPU_OPS_PTR)
 #endif /* ENABLE_PAUTH */
 
+#if CTX_LAZY_FPREGS
+/* Offsets of fpregs_live and fpregs_next, size 8 bytes each */
+#define CPU_DATA_FPREGS_LIVE_OFFSET	CPU_DATA_PAUTH_END
+#define CPU_DATA_FPREGS_NEXT_OFFSET	(0x8 + CPU_DATA_FPREGS_LIVE_OFFSET)
+#define CPU_DATA_CRASH_BUF_OFFSET	(0x10 + CPU_DATA_FPREGS_LIVE_OFFSET)
+#else /* CTX_LAZY_FPREGS */
+#define CPU_DATA_CRASH_BUF_OFFSET	CPU_DATA_PAUTH_END
+#endif /* CTX_LAZY_FPREGS */
+
 /* need enough space in crash buffer to save 8 registers */
 #define CPU_DATA_CRASH_BUF_SIZE		64
 
@@ -125,6 +134,15 @@ typedef struct cpu_data {
 #if ENABLE_PAUTH
 	uint64_t apiakey[2];
 #endif
+#if CTX_LAZY_FPREGS
+	/*
+	 * FP/SIMD register contexts of the world whose state is in the
+	 * registers and of the world being run. They are switched on the
+	 * first FP/SIMD access when they differ.
+	 */
+	void *fpregs_live;
+	void *fpregs_next;
+#endif
 #if CRASH_REPORTING
 	u_register_t crash_buf[CPU_DATA_CRASH_BUF_SIZE >> 3];
 #endif
@@ -152,6 +170,15 @@ CASSERT(CPU_DATA_APIAKEY_OFFSET == __builtin_offsetof
 	assert_cpu_data_pauth_stack_offset_mismatch);
 #endif
 
+#if CTX_LAZY_FPREGS
+CASSERT(CPU_DATA_FPREGS_LIVE_OFFSET == __builtin_offsetof
+	(cpu_data_t, fpregs_live),
+	assert_cpu_data_fpregs_live_offset_mismatch);
+CASSERT(CPU_DATA_FPREGS_NEXT_OFFSET == __builtin_offsetof
+	(cpu_data_t, fpregs_next),
+	assert_cpu_data_fpregs_next_offset_mismatch);
+#endif
+
 #if CRASH_REPORTING
 /* verify assembler offsets match data structures */
 CASSERT(CPU_DATA_CRASH_BUF_OFFSET == __builtin_offsetof
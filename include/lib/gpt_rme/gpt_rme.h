@@ -263,12 +263,12 @@ void gpt_disable(void);
  * transition request occurs it is routed to this function where the request is
  * validated then fulfilled if possible.
  *
- * TODO: implement support for transitioning multiple granules at once.
+ * Only a single granule is transitioned per request.
  *
  * Parameters
  *   base: Base address of the region to transition, must be aligned to granule
  *         size.
- *   size: Size of region to transition, must be aligned to granule size.
+ *   size: Size of region to transition, must be the granule size.
  *   src_sec_state: Security state of the originating SMC invoking the API.
  *
  * Return
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2020, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -40,7 +40,8 @@
  */
 #define PMF_SMC_GET_TIMESTAMP_32	U(0x82000010)
 #define PMF_SMC_GET_TIMESTAMP_64	U(0xC2000010)
-#define PMF_NUM_SMC_CALLS		2
+#define PMF_SMC_GET_SMC_STATS_64	U(0xC2000011)
+#define PMF_NUM_SMC_CALLS		3
 
 /*
  * The macros below are used to identify
@@ -50,10 +51,25 @@
 #define PMF_FID_VALUE	U(0)
 #define is_pmf_fid(_fid)	(((_fid) & PMF_FID_MASK) == PMF_FID_VALUE)
 
+/*
+ * Number of buckets of the log2 histogram of the time spent handling an SMC
+ * function, returned by PMF_SMC_GET_SMC_STATS_64 two per register in x4-x17.
+ */
+#define PMF_SMC_STATS_HIST_BUCKETS	U(28)
+
 /* Following are the supported PMF service IDs */
 #define PMF_PSCI_STAT_SVC_ID	0
 #define PMF_RT_INSTR_SVC_ID	1
 
+/* Statistics of one SMC function ID on one CPU, kept if ENABLE_SMC_STATS */
+typedef struct pmf_smc_stats {
+	uint64_t count;		/* Number of calls */
+	uint64_t ticks;		/* System counter ticks spent in the handler */
+	uint32_t smc_fid;
+	/* Calls that took [2^i, 2^(i+1)) ticks, the last bucket saturates */
+	uint32_t hist[PMF_SMC_STATS_HIST_BUCKETS];
+} pmf_smc_stats_t;
+
 /*******************************************************************************
  * Function & variable prototypes
  ******************************************************************************/
@@ -63,6 +79,9 @@ int pmf_get_timestamp_smc(unsigned int tid,
 		unsigned int flags,
 		unsigned long long *ts_value);
 int pmf_setup(void);
+void pmf_smc_stats_record(uint32_t smc_fid, uint64_t start);
+int pmf_smc_stats_get(u_register_t mpidr, u_register_t index,
+		      pmf_smc_stats_t *stats);
 uintptr_t pmf_smc_handler(unsigned int smc_fid,
 		u_register_t x1,
 		u_register_t x2,
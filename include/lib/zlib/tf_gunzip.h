@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -10,7 +10,12 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <common/image_decompress.h>
+
 int gunzip(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
 	   size_t out_len, uintptr_t work_buf, size_t work_len);
 
+/* gunzip() for use with image_decompress_init_stream() */
+extern const decompressor_stream_t gunzip_stream;
+
 #endif /* TF_GUNZIP_H */
@@ -158,6 +158,7 @@ int plat_try_next_boot_source(void);
 
 #if MEASURED_BOOT
 int plat_mboot_measure_image(unsigned int image_id, image_info_t *image_data);
+bool plat_mboot_is_event_log_image(unsigned int image_id);
 int plat_mboot_measure_critical_data(unsigned int critical_data_id,
 				     const void *base,
 				     size_t size);
@@ -169,6 +170,11 @@ static inline int plat_mboot_measure_image(unsigned int image_id __unused,
 {
 	return 0;
 }
+static inline bool plat_mboot_is_event_log_image(
+					unsigned int image_id __unused)
+{
+	return false;
+}
 static inline int plat_mboot_measure_critical_data(
 					unsigned int critical_data_id __unused,
 					const void *base __unused,
@@ -285,6 +291,13 @@ static inline void bl2_plat_mboot_finish(void)
 }
 #endif /* MEASURED_BOOT */
 
+#if BL2_WORKERS
+unsigned int bl2_plat_workers_start(uintptr_t entrypoint);
+void bl2_plat_worker_exit(void) __dead2;
+bool bl2_plat_worker_has_exited(unsigned int core_pos);
+void bl2_plat_worker_revoke(unsigned int core_pos);
+#endif /* BL2_WORKERS */
+
 /*******************************************************************************
  * Mandatory BL2 at EL3 functions: Must be implemented
  * if RESET_TO_BL2 image is supported
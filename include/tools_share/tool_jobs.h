@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef TOOL_JOBS_H
+#define TOOL_JOBS_H
+
+/*
+ * Thread pool shared by the host tools that process several files at once,
+ * built from tools/tools_share/tool_jobs.c.
+ */
+
+/* Number of jobs given on the command line, or -1 if it is not valid */
+int tool_jobs_parse(const char *num_jobs_str);
+
+/* Number of jobs used without --jobs: one per online CPU */
+int tool_jobs_default(void);
+
+/*
+ * Call 'fn' with 'arg' for each index from 0 to 'num' - 1, using up to
+ * 'num_jobs' threads including the calling one. The calls can be made in any
+ * order, and concurrently. Returns once all of them are done.
+ */
+void tool_jobs_run(int num_jobs, void (*fn)(void *arg, int i), void *arg,
+		   int num);
+
+#endif /* TOOL_JOBS_H */
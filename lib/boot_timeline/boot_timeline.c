@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdint.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <lib/boot_timeline.h>
+#include <lib/transfer_list.h>
+
+#include <platform_def.h>
+
+#ifdef IMAGE_BL1
+#define BOOT_TIMELINE_BL_STAGE		U(1)
+#else
+#define BOOT_TIMELINE_BL_STAGE		U(2)
+#endif
+
+#ifdef PLAT_BOOT_TIMELINE_BASE
+/*
+ * The platform provides memory that BL1 and BL2 both see, so that the timeline
+ * published by BL2 covers the loading of BL2 by BL1 as well.
+ */
+#define TIMELINE_BASE			PLAT_BOOT_TIMELINE_BASE
+#define TIMELINE_SIZE			PLAT_BOOT_TIMELINE_SIZE
+#else
+#ifndef PLAT_BOOT_TIMELINE_MAX_RECORDS
+#define PLAT_BOOT_TIMELINE_MAX_RECORDS	U(64)
+#endif
+
+static uint64_t timeline_buf[(sizeof(struct boot_timeline_header) +
+			      (PLAT_BOOT_TIMELINE_MAX_RECORDS *
+			       sizeof(struct boot_timeline_record))) /
+			     sizeof(uint64_t)];
+
+#define TIMELINE_BASE			((uintptr_t)timeline_buf)
+#define TIMELINE_SIZE			sizeof(timeline_buf)
+#endif /* PLAT_BOOT_TIMELINE_BASE */
+
+#define TIMELINE_MAX_RECORDS						\
+	((TIMELINE_SIZE - sizeof(struct boot_timeline_header)) /	\
+	 sizeof(struct boot_timeline_record))
+
+static struct boot_timeline_header *const timeline =
+	(struct boot_timeline_header *)TIMELINE_BASE;
+
+static struct boot_timeline_record *timeline_records(void)
+{
+	return (struct boot_timeline_record *)(timeline + 1);
+}
+
+/*******************************************************************************
+ * Start the timeline. BL2 carries on with the one started by BL1 if there is
+ * one in the memory provided by the platform.
+ ******************************************************************************/
+void boot_timeline_init(void)
+{
+#ifdef IMAGE_BL2
+	if ((timeline->signature == BOOT_TIMELINE_SIGNATURE) &&
+	    (timeline->version == BOOT_TIMELINE_VERSION) &&
+	    (timeline->count <= TIMELINE_MAX_RECORDS)) {
+		return;
+	}
+#endif
+	timeline->signature = BOOT_TIMELINE_SIGNATURE;
+	timeline->version = BOOT_TIMELINE_VERSION;
+	timeline->count = 0U;
+	timeline->cnt_freq = read_cntfrq_el0();
+}
+
+uint64_t boot_timeline_now(void)
+{
+	return read_cntpct_el0();
+}
+
+/*******************************************************************************
+ * Record that 'image_id' spent the time since 'start' in 'phase'. Records that
+ * do not fit are dropped.
+ ******************************************************************************/
+void boot_timeline_record(unsigned int image_id, unsigned int phase,
+			  uint64_t start)
+{
+	struct boot_timeline_record *records = timeline_records();
+	uint64_t duration = read_cntpct_el0() - start;
+	unsigned int count = timeline->count;
+
+	assert(timeline->signature == BOOT_TIMELINE_SIGNATURE);
+
+	if (count >= TIMELINE_MAX_RECORDS) {
+		return;
+	}
+
+	if (image_id == BOOT_TIMELINE_LAST_IMAGE) {
+		image_id = (count != 0U) ? records[count - 1U].image_id :
+					   BOOT_TIMELINE_LAST_IMAGE;
+	}
+
+	records[count].start = start;
+	records[count].duration = (duration > UINT32_MAX) ?
+				  UINT32_MAX : (uint32_t)duration;
+	records[count].image_id = (uint16_t)image_id;
+	records[count].phase = (uint8_t)phase;
+	records[count].bl_stage = BOOT_TIMELINE_BL_STAGE;
+	timeline->count = (uint16_t)(count + 1U);
+}
+
+/*******************************************************************************
+ * Add the timeline to the transfer list 'tl'.
+ ******************************************************************************/
+int boot_timeline_publish(struct transfer_list_header *tl)
+{
+#if TRANSFER_LIST
+	uint32_t size = sizeof(*timeline) +
+			(timeline->count * sizeof(struct boot_timeline_record));
+
+	if (transfer_list_add(tl, TL_TAG_BOOT_TIMELINE, size,
+			      timeline) == NULL) {
+		ERROR("Failed to add the boot timeline to the transfer list\n");
+		return -ENOMEM;
+	}
+
+	VERBOSE("Boot timeline of %u records published\n", timeline->count);
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif /* TRANSFER_LIST */
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2023, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2026, Arm Limited and Contributors. All rights reserved.
  * Copyright (c) 2022, NVIDIA Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -45,6 +45,9 @@ static bool has_secure_perworld_init;
 static void manage_extensions_nonsecure(cpu_context_t *ctx);
 static void manage_extensions_secure(cpu_context_t *ctx);
 static void manage_extensions_secure_per_world(void);
+#if CTX_INCLUDE_EL2_REGS
+static void el2_sysregs_ops_init(void);
+#endif
 
 static void setup_el1_context(cpu_context_t *ctx, const struct entry_point_info *ep)
 {
@@ -520,9 +523,12 @@ static void setup_context_common(cpu_context_t *ctx, const entry_point_info_t *e
 void __init cm_init(void)
 {
 	/*
-	 * The context management library has only global data to initialize, but
-	 * that will be done when the BSS is zeroed out.
+	 * The context management library has only global data to initialize,
+	 * most of it done when the BSS is zeroed out.
 	 */
+#if CTX_INCLUDE_EL2_REGS
+	el2_sysregs_ops_init();
+#endif
 }
 
 /*******************************************************************************
@@ -996,9 +1002,6 @@ void cm_prepare_el3_exit(uint32_t security_state)
 static void el2_sysregs_context_save_fgt(el2_sysregs_t *ctx)
 {
 	write_ctx_reg(ctx, CTX_HDFGRTR_EL2, read_hdfgrtr_el2());
-	if (is_feat_amu_supported()) {
-		write_ctx_reg(ctx, CTX_HAFGRTR_EL2, read_hafgrtr_el2());
-	}
 	write_ctx_reg(ctx, CTX_HDFGWTR_EL2, read_hdfgwtr_el2());
 	write_ctx_reg(ctx, CTX_HFGITR_EL2, read_hfgitr_el2());
 	write_ctx_reg(ctx, CTX_HFGRTR_EL2, read_hfgrtr_el2());
@@ -1008,9 +1011,6 @@ static void el2_sysregs_context_save_fgt(el2_sysregs_t *ctx)
 static void el2_sysregs_context_restore_fgt(el2_sysregs_t *ctx)
 {
 	write_hdfgrtr_el2(read_ctx_reg(ctx, CTX_HDFGRTR_EL2));
-	if (is_feat_amu_supported()) {
-		write_hafgrtr_el2(read_ctx_reg(ctx, CTX_HAFGRTR_EL2));
-	}
 	write_hdfgwtr_el2(read_ctx_reg(ctx, CTX_HDFGWTR_EL2));
 	write_hfgitr_el2(read_ctx_reg(ctx, CTX_HFGITR_EL2));
 	write_hfgrtr_el2(read_ctx_reg(ctx, CTX_HFGRTR_EL2));
@@ -1216,6 +1216,252 @@ static void el2_sysregs_context_restore_common(el2_sysregs_t *ctx)
 	write_vttbr_el2(read_ctx_reg(ctx, CTX_VTTBR_EL2));
 }
 
+/* HAFGRTR_EL2 is only present if both FEAT_FGT and FEAT_AMU are */
+static void el2_sysregs_context_save_fgt_amu(el2_sysregs_t *ctx)
+{
+	write_ctx_reg(ctx, CTX_HAFGRTR_EL2, read_hafgrtr_el2());
+}
+
+static void el2_sysregs_context_restore_fgt_amu(el2_sysregs_t *ctx)
+{
+	write_hafgrtr_el2(read_ctx_reg(ctx, CTX_HAFGRTR_EL2));
+}
+
+static void el2_sysregs_context_save_ecv_v2(el2_sysregs_t *ctx)
+{
+	write_ctx_reg(ctx, CTX_CNTPOFF_EL2, read_cntpoff_el2());
+}
+
+static void el2_sysregs_context_restore_ecv_v2(el2_sysregs_t *ctx)
+{
+	write_cntpoff_el2(read_ctx_reg(ctx, CTX_CNTPOFF_EL2));
+}
+
+static void el2_sysregs_context_save_vhe(el2_sysregs_t *ctx)
+{
+	write_ctx_reg(ctx, CTX_CONTEXTIDR_EL2, read_contextidr_el2());
+	write_ctx_reg(ctx, CTX_TTBR1_EL2, read_ttbr1_el2());
+}
+
+static void el2_sysregs_context_restore_vhe(el2_sysregs_t *ctx)
+{
+	write_contextidr_el2(read_ctx_reg(ctx, CTX_CONTEXTIDR_EL2));
+	write_ttbr1_el2(read_ctx_reg(ctx, CTX_TTBR1_EL2));
+}
+
+static void el2_sysregs_context_save_ras(el2_sysregs_t *ctx)
+{
+	write_ctx_reg(ctx, CTX_VDISR_EL2, read_vdisr_el2());
+	write_ctx_reg(ctx, CTX_VSESR_EL2, read_vsesr_el2());
+}
+
+static void el2_sysregs_context_restore_ras(el2_sysregs_t *ctx)
+{
+	write_vdisr_el2(read_ctx_reg(ctx, CTX_VDISR_EL2));
+	write_vsesr_el2(read_ctx_reg(ctx, CTX_VSESR_EL2));
+}
+
+static void el2_sysregs_context_save_nv2(el2_sysregs_t *ctx)
+{
+	write_ctx_reg(ctx, CTX_VNCR_EL2, read_vncr_el2());
+}
+
+static void el2_sysregs_context_restore_nv2(el2_sysregs_t *ctx)
+{
+	write_vncr_el2(read_ctx_reg(ctx, CTX_VNCR_EL2));
+}
+
+static void el2_sysregs_context_save_trf(el2_sysregs_t *ctx)
+{
+	write_ctx_reg(ctx, CTX_TRFCR_EL2, read_trfcr_el2());
+}
+
+static void el2_sysregs_context_restore_trf(el2_sysregs_t *ctx)
+{
+	write_trfcr_el2(read_ctx_reg(ctx, CTX_TRFCR_EL2));
+}
+
+static void el2_sysregs_context_save_csv2_2(el2_sysregs_t *ctx)
+{
+	write_ctx_reg(ctx, CTX_SCXTNUM_EL2, read_scxtnum_el2());
+}
+
+static void el2_sysregs_context_restore_csv2_2(el2_sysregs_t *ctx)
+{
+	write_scxtnum_el2(read_ctx_reg(ctx, CTX_SCXTNUM_EL2));
+}
+
+static void el2_sysregs_context_save_hcx(el2_sysregs_t *ctx)
+{
+	write_ctx_reg(ctx, CTX_HCRX_EL2, read_hcrx_el2());
+}
+
+static void el2_sysregs_context_restore_hcx(el2_sysregs_t *ctx)
+{
+	write_hcrx_el2(read_ctx_reg(ctx, CTX_HCRX_EL2));
+}
+
+static void el2_sysregs_context_save_tcr2(el2_sysregs_t *ctx)
+{
+	write_ctx_reg(ctx, CTX_TCR2_EL2, read_tcr2_el2());
+}
+
+static void el2_sysregs_context_restore_tcr2(el2_sysregs_t *ctx)
+{
+	write_tcr2_el2(read_ctx_reg(ctx, CTX_TCR2_EL2));
+}
+
+static void el2_sysregs_context_save_sxpie(el2_sysregs_t *ctx)
+{
+	write_ctx_reg(ctx, CTX_PIRE0_EL2, read_pire0_el2());
+	write_ctx_reg(ctx, CTX_PIR_EL2, read_pir_el2());
+}
+
+static void el2_sysregs_context_restore_sxpie(el2_sysregs_t *ctx)
+{
+	write_pire0_el2(read_ctx_reg(ctx, CTX_PIRE0_EL2));
+	write_pir_el2(read_ctx_reg(ctx, CTX_PIR_EL2));
+}
+
+static void el2_sysregs_context_save_s2pie(el2_sysregs_t *ctx)
+{
+	write_ctx_reg(ctx, CTX_S2PIR_EL2, read_s2pir_el2());
+}
+
+static void el2_sysregs_context_restore_s2pie(el2_sysregs_t *ctx)
+{
+	write_s2pir_el2(read_ctx_reg(ctx, CTX_S2PIR_EL2));
+}
+
+static void el2_sysregs_context_save_sxpoe(el2_sysregs_t *ctx)
+{
+	write_ctx_reg(ctx, CTX_POR_EL2, read_por_el2());
+}
+
+static void el2_sysregs_context_restore_sxpoe(el2_sysregs_t *ctx)
+{
+	write_por_el2(read_ctx_reg(ctx, CTX_POR_EL2));
+}
+
+static void el2_sysregs_context_save_gcs(el2_sysregs_t *ctx)
+{
+	write_ctx_reg(ctx, CTX_GCSPR_EL2, read_gcspr_el2());
+	write_ctx_reg(ctx, CTX_GCSCR_EL2, read_gcscr_el2());
+}
+
+static void el2_sysregs_context_restore_gcs(el2_sysregs_t *ctx)
+{
+	write_gcscr_el2(read_ctx_reg(ctx, CTX_GCSCR_EL2));
+	write_gcspr_el2(read_ctx_reg(ctx, CTX_GCSPR_EL2));
+}
+
+/*
+ * Save and restore routines of the EL2 system registers of a feature, on top
+ * of the ones of every PE with EL2.
+ */
+typedef struct el2_sysregs_ops {
+	void (*save)(el2_sysregs_t *ctx);
+	void (*restore)(el2_sysregs_t *ctx);
+} el2_sysregs_ops_t;
+
+#define EL2_SYSREGS_OPS(_feat)						\
+	{								\
+		.save = el2_sysregs_context_save_##_feat,		\
+		.restore = el2_sysregs_context_restore_##_feat		\
+	}
+
+/*
+ * Features with EL2 system registers of their own, in the order they are
+ * saved and restored, with whether the build always enables them and whether
+ * the PE implements them.
+ */
+#define FEAT_ALWAYS(_flag)	((_flag) == FEAT_STATE_ALWAYS)
+
+#define EL2_SYSREGS_FEATURES(_X)					\
+	_X(mpam, FEAT_ALWAYS(ENABLE_FEAT_MPAM),				\
+	   is_feat_mpam_supported())					\
+	_X(fgt, FEAT_ALWAYS(ENABLE_FEAT_FGT),				\
+	   is_feat_fgt_supported())					\
+	_X(fgt_amu, FEAT_ALWAYS(ENABLE_FEAT_FGT) &&			\
+	   FEAT_ALWAYS(ENABLE_FEAT_AMU),				\
+	   is_feat_fgt_supported() && is_feat_amu_supported())		\
+	_X(ecv_v2, FEAT_ALWAYS(ENABLE_FEAT_ECV),			\
+	   is_feat_ecv_v2_supported())					\
+	_X(vhe, FEAT_ALWAYS(ENABLE_FEAT_VHE),				\
+	   is_feat_vhe_supported())					\
+	_X(ras, FEAT_ALWAYS(ENABLE_FEAT_RAS),				\
+	   is_feat_ras_supported())					\
+	_X(nv2, FEAT_ALWAYS(CTX_INCLUDE_NEVE_REGS),			\
+	   is_feat_nv2_supported())					\
+	_X(trf, FEAT_ALWAYS(ENABLE_TRF_FOR_NS),				\
+	   is_feat_trf_supported())					\
+	_X(csv2_2, FEAT_ALWAYS(ENABLE_FEAT_CSV2_2),			\
+	   is_feat_csv2_2_supported())					\
+	_X(hcx, FEAT_ALWAYS(ENABLE_FEAT_HCX),				\
+	   is_feat_hcx_supported())					\
+	_X(tcr2, FEAT_ALWAYS(ENABLE_FEAT_TCR2),				\
+	   is_feat_tcr2_supported())					\
+	_X(sxpie, FEAT_ALWAYS(ENABLE_FEAT_S1PIE) ||			\
+	   FEAT_ALWAYS(ENABLE_FEAT_S2PIE),				\
+	   is_feat_sxpie_supported())					\
+	_X(s2pie, FEAT_ALWAYS(ENABLE_FEAT_S2PIE),			\
+	   is_feat_s2pie_supported())					\
+	_X(sxpoe, FEAT_ALWAYS(ENABLE_FEAT_S1POE) ||			\
+	   FEAT_ALWAYS(ENABLE_FEAT_S2POE),				\
+	   is_feat_sxpoe_supported())					\
+	_X(gcs, FEAT_ALWAYS(ENABLE_FEAT_GCS),				\
+	   is_feat_gcs_supported())
+
+#define EL2_SYSREGS_OPS_DEFINE(_feat, _always, _supported)		\
+	static const el2_sysregs_ops_t el2_##_feat##_ops =		\
+		EL2_SYSREGS_OPS(_feat);
+
+EL2_SYSREGS_FEATURES(EL2_SYSREGS_OPS_DEFINE)
+
+#define EL2_SYSREGS_OPS_MAX		15U
+
+/*
+ * Routines of the features the build leaves to be checked at run time and
+ * that the PE implements, set up once by cm_init() so that world switches do
+ * not go through the feature checks. All the PEs are expected to implement
+ * the same features, as for feature detection. The registers of the features
+ * always enabled are saved and restored directly.
+ */
+static const el2_sysregs_ops_t *el2_sysregs_ops[EL2_SYSREGS_OPS_MAX];
+static unsigned int el2_sysregs_ops_num;
+
+static void el2_sysregs_ops_add(const el2_sysregs_ops_t *ops)
+{
+	assert(el2_sysregs_ops_num < EL2_SYSREGS_OPS_MAX);
+	el2_sysregs_ops[el2_sysregs_ops_num++] = ops;
+}
+
+#define EL2_SYSREGS_OPS_ADD_CHECKED(_feat, _always, _supported)	\
+	if (!(_always) && (_supported)) {				\
+		el2_sysregs_ops_add(&el2_##_feat##_ops);		\
+	}
+
+/*
+ * The checks of the features disabled or always enabled at build time fold
+ * away, and so do the routines saving the registers of the disabled ones.
+ */
+static void __init el2_sysregs_ops_init(void)
+{
+	el2_sysregs_ops_num = 0U;
+
+	EL2_SYSREGS_FEATURES(EL2_SYSREGS_OPS_ADD_CHECKED)
+}
+
+#define EL2_SYSREGS_SAVE_ALWAYS(_feat, _always, _supported)		\
+	if (_always) {							\
+		el2_sysregs_context_save_##_feat(el2_sysregs_ctx);	\
+	}
+
+#define EL2_SYSREGS_RESTORE_ALWAYS(_feat, _always, _supported)	\
+	if (_always) {							\
+		el2_sysregs_context_restore_##_feat(el2_sysregs_ctx);	\
+	}
+
 /*******************************************************************************
  * Save EL2 sysreg context
  ******************************************************************************/
@@ -1223,6 +1469,7 @@ void cm_el2_sysregs_context_save(uint32_t security_state)
 {
 	cpu_context_t *ctx;
 	el2_sysregs_t *el2_sysregs_ctx;
+	unsigned int i;
 
 	ctx = cm_get_context(security_state);
 	assert(ctx != NULL);
@@ -1233,59 +1480,9 @@ void cm_el2_sysregs_context_save(uint32_t security_state)
 #if CTX_INCLUDE_MTE_REGS
 	write_ctx_reg(el2_sysregs_ctx, CTX_TFSR_EL2, read_tfsr_el2());
 #endif
-	if (is_feat_mpam_supported()) {
-		el2_sysregs_context_save_mpam(el2_sysregs_ctx);
-	}
-
-	if (is_feat_fgt_supported()) {
-		el2_sysregs_context_save_fgt(el2_sysregs_ctx);
-	}
-
-	if (is_feat_ecv_v2_supported()) {
-		write_ctx_reg(el2_sysregs_ctx, CTX_CNTPOFF_EL2, read_cntpoff_el2());
-	}
-
-	if (is_feat_vhe_supported()) {
-		write_ctx_reg(el2_sysregs_ctx, CTX_CONTEXTIDR_EL2, read_contextidr_el2());
-		write_ctx_reg(el2_sysregs_ctx, CTX_TTBR1_EL2, read_ttbr1_el2());
-	}
-
-	if (is_feat_ras_supported()) {
-		write_ctx_reg(el2_sysregs_ctx, CTX_VDISR_EL2, read_vdisr_el2());
-		write_ctx_reg(el2_sysregs_ctx, CTX_VSESR_EL2, read_vsesr_el2());
-	}
-
-	if (is_feat_nv2_supported()) {
-		write_ctx_reg(el2_sysregs_ctx, CTX_VNCR_EL2, read_vncr_el2());
-	}
-
-	if (is_feat_trf_supported()) {
-		write_ctx_reg(el2_sysregs_ctx, CTX_TRFCR_EL2, read_trfcr_el2());
-	}
-
-	if (is_feat_csv2_2_supported()) {
-		write_ctx_reg(el2_sysregs_ctx, CTX_SCXTNUM_EL2, read_scxtnum_el2());
-	}
-
-	if (is_feat_hcx_supported()) {
-		write_ctx_reg(el2_sysregs_ctx, CTX_HCRX_EL2, read_hcrx_el2());
-	}
-	if (is_feat_tcr2_supported()) {
-		write_ctx_reg(el2_sysregs_ctx, CTX_TCR2_EL2, read_tcr2_el2());
-	}
-	if (is_feat_sxpie_supported()) {
-		write_ctx_reg(el2_sysregs_ctx, CTX_PIRE0_EL2, read_pire0_el2());
-		write_ctx_reg(el2_sysregs_ctx, CTX_PIR_EL2, read_pir_el2());
-	}
-	if (is_feat_s2pie_supported()) {
-		write_ctx_reg(el2_sysregs_ctx, CTX_S2PIR_EL2, read_s2pir_el2());
-	}
-	if (is_feat_sxpoe_supported()) {
-		write_ctx_reg(el2_sysregs_ctx, CTX_POR_EL2, read_por_el2());
-	}
-	if (is_feat_gcs_supported()) {
-		write_ctx_reg(el2_sysregs_ctx, CTX_GCSPR_EL2, read_gcspr_el2());
-		write_ctx_reg(el2_sysregs_ctx, CTX_GCSCR_EL2, read_gcscr_el2());
+	EL2_SYSREGS_FEATURES(EL2_SYSREGS_SAVE_ALWAYS)
+	for (i = 0U; i < el2_sysregs_ops_num; i++) {
+		el2_sysregs_ops[i]->save(el2_sysregs_ctx);
 	}
 }
 
@@ -1296,6 +1493,7 @@ void cm_el2_sysregs_context_restore(uint32_t security_state)
 {
 	cpu_context_t *ctx;
 	el2_sysregs_t *el2_sysregs_ctx;
+	unsigned int i;
 
 	ctx = cm_get_context(security_state);
 	assert(ctx != NULL);
@@ -1306,58 +1504,9 @@ void cm_el2_sysregs_context_restore(uint32_t security_state)
 #if CTX_INCLUDE_MTE_REGS
 	write_tfsr_el2(read_ctx_reg(el2_sysregs_ctx, CTX_TFSR_EL2));
 #endif
-	if (is_feat_mpam_supported()) {
-		el2_sysregs_context_restore_mpam(el2_sysregs_ctx);
-	}
-
-	if (is_feat_fgt_supported()) {
-		el2_sysregs_context_restore_fgt(el2_sysregs_ctx);
-	}
-
-	if (is_feat_ecv_v2_supported()) {
-		write_cntpoff_el2(read_ctx_reg(el2_sysregs_ctx, CTX_CNTPOFF_EL2));
-	}
-
-	if (is_feat_vhe_supported()) {
-		write_contextidr_el2(read_ctx_reg(el2_sysregs_ctx, CTX_CONTEXTIDR_EL2));
-		write_ttbr1_el2(read_ctx_reg(el2_sysregs_ctx, CTX_TTBR1_EL2));
-	}
-
-	if (is_feat_ras_supported()) {
-		write_vdisr_el2(read_ctx_reg(el2_sysregs_ctx, CTX_VDISR_EL2));
-		write_vsesr_el2(read_ctx_reg(el2_sysregs_ctx, CTX_VSESR_EL2));
-	}
-
-	if (is_feat_nv2_supported()) {
-		write_vncr_el2(read_ctx_reg(el2_sysregs_ctx, CTX_VNCR_EL2));
-	}
-	if (is_feat_trf_supported()) {
-		write_trfcr_el2(read_ctx_reg(el2_sysregs_ctx, CTX_TRFCR_EL2));
-	}
-
-	if (is_feat_csv2_2_supported()) {
-		write_scxtnum_el2(read_ctx_reg(el2_sysregs_ctx, CTX_SCXTNUM_EL2));
-	}
-
-	if (is_feat_hcx_supported()) {
-		write_hcrx_el2(read_ctx_reg(el2_sysregs_ctx, CTX_HCRX_EL2));
-	}
-	if (is_feat_tcr2_supported()) {
-		write_tcr2_el2(read_ctx_reg(el2_sysregs_ctx, CTX_TCR2_EL2));
-	}
-	if (is_feat_sxpie_supported()) {
-		write_pire0_el2(read_ctx_reg(el2_sysregs_ctx, CTX_PIRE0_EL2));
-		write_pir_el2(read_ctx_reg(el2_sysregs_ctx, CTX_PIR_EL2));
-	}
-	if (is_feat_s2pie_supported()) {
-		write_s2pir_el2(read_ctx_reg(el2_sysregs_ctx, CTX_S2PIR_EL2));
-	}
-	if (is_feat_sxpoe_supported()) {
-		write_por_el2(read_ctx_reg(el2_sysregs_ctx, CTX_POR_EL2));
-	}
-	if (is_feat_gcs_supported()) {
-		write_gcscr_el2(read_ctx_reg(el2_sysregs_ctx, CTX_GCSCR_EL2));
-		write_gcspr_el2(read_ctx_reg(el2_sysregs_ctx, CTX_GCSPR_EL2));
+	EL2_SYSREGS_FEATURES(EL2_SYSREGS_RESTORE_ALWAYS)
+	for (i = 0U; i < el2_sysregs_ops_num; i++) {
+		el2_sysregs_ops[i]->restore(el2_sysregs_ctx);
 	}
 }
 #endif /* CTX_INCLUDE_EL2_REGS */
@@ -1429,6 +1578,101 @@ void cm_el1_sysregs_context_restore(uint32_t security_state)
 #endif
 }
 
+#if CTX_INCLUDE_FPREGS
+/*******************************************************************************
+ * The next two functions are used by runtime services to save and restore the
+ * FP/SIMD context on the 'cpu_context' structure for the specified security
+ * state. With CTX_LAZY_FPREGS they only record which context is to own the
+ * registers, and the registers are switched by cm_handle_fpregs_trap() on the
+ * first FP/SIMD access of the world entered.
+ ******************************************************************************/
+void cm_fpregs_context_save(uint32_t security_state)
+{
+	cpu_context_t *ctx;
+
+	ctx = cm_get_context(security_state);
+	assert(ctx != NULL);
+
+#if CTX_LAZY_FPREGS
+	/*
+	 * The registers are only saved once another world claims them. Until
+	 * the first switch, they hold the state of the world that ran last.
+	 */
+	if ((get_cpu_data(fpregs_live) == NULL) &&
+	    (get_cpu_data(fpregs_next) == NULL)) {
+		set_cpu_data(fpregs_live, get_fpregs_ctx(ctx));
+	}
+
+	/* Whichever world runs until the next restore must not see them */
+	set_cpu_data(fpregs_next, NULL);
+#else
+	fpregs_context_save(get_fpregs_ctx(ctx));
+#endif
+}
+
+void cm_fpregs_context_restore(uint32_t security_state)
+{
+	cpu_context_t *ctx;
+
+	ctx = cm_get_context(security_state);
+	assert(ctx != NULL);
+
+#if CTX_LAZY_FPREGS
+	/* el3_exit() traps FP/SIMD accesses if someone else owns them */
+	set_cpu_data(fpregs_next, get_fpregs_ctx(ctx));
+#else
+	fpregs_context_restore(get_fpregs_ctx(ctx));
+#endif
+}
+
+#if CTX_LAZY_FPREGS
+/*******************************************************************************
+ * Save the FP/SIMD registers to the context owning them, if any, and load them
+ * from 'next' unless it is NULL.
+ ******************************************************************************/
+static void fpregs_switch(fp_regs_t *next)
+{
+	fp_regs_t *live = get_cpu_data(fpregs_live);
+
+	/* CPTR_EL3.TFP traps the accesses of EL3 as well */
+	write_cptr_el3(read_cptr_el3() & ~TFP_BIT);
+	isb();
+
+	if (live != NULL) {
+		fpregs_context_save(live);
+	}
+
+	if (next != NULL) {
+		fpregs_context_restore(next);
+	}
+
+	set_cpu_data(fpregs_live, next);
+}
+
+/*******************************************************************************
+ * Handle an FP/SIMD access of a lower EL trapped by el3_exit() setting
+ * CPTR_EL3.TFP. The registers are handed over to the world running, and the
+ * access is retried once el3_exit() finds that it owns them.
+ ******************************************************************************/
+void cm_handle_fpregs_trap(void)
+{
+	fpregs_switch(get_cpu_data(fpregs_next));
+}
+
+/*******************************************************************************
+ * Save the FP/SIMD registers to the context owning them before they lose their
+ * content, e.g. when this CPU is powered down. They are loaded again on the
+ * next FP/SIMD access.
+ ******************************************************************************/
+void cm_fpregs_context_flush(void)
+{
+	if (get_cpu_data(fpregs_live) != NULL) {
+		fpregs_switch(NULL);
+	}
+}
+#endif /* CTX_LAZY_FPREGS */
+#endif /* CTX_INCLUDE_FPREGS */
+
 /*******************************************************************************
  * This function populates ELR_EL3 member of 'cpu_context' pertaining to the
  * given security state with the given entrypoint
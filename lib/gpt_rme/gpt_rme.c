@@ -13,10 +13,12 @@
 #include <arch.h>
 #include <arch_helpers.h>
 #include <common/debug.h>
+#include <lib/cassert.h>
 #include "gpt_rme_private.h"
 #include <lib/gpt_rme/gpt_rme.h>
 #include <lib/smccc.h>
 #include <lib/spinlock.h>
+#include <lib/utils_def.h>
 #include <lib/xlat_tables/xlat_tables_v2.h>
 
 #if !ENABLE_RME
@@ -954,64 +956,201 @@ int gpt_runtime_init(void)
 }
 
 /*
- * The L1 descriptors are protected by a spinlock to ensure that multiple
- * CPUs do not attempt to change the descriptors at once. In the future it
- * would be better to have separate spinlocks for each L1 descriptor.
+ * The L1 descriptors are protected by spinlocks to ensure that multiple CPUs
+ * do not attempt to change the same descriptors at once. There are
+ * RME_GPT_LOCK_COUNT locks and each L1 table, i.e. each L0 region, is guarded
+ * by the lock selected by the low bits of its L0 index, so that transitions
+ * in different L0 regions can proceed in parallel. A transition takes the
+ * locks of all the L0 regions its range spans, in ascending order to avoid
+ * deadlocks. With a single lock all transitions are serialised.
  */
-static spinlock_t gpt_lock;
+CASSERT((RME_GPT_LOCK_COUNT > 0) && (RME_GPT_LOCK_COUNT <= 64) &&
+	((RME_GPT_LOCK_COUNT & (RME_GPT_LOCK_COUNT - 1)) == 0),
+	assert_rme_gpt_lock_count_invalid);
+
+static spinlock_t gpt_locks[RME_GPT_LOCK_COUNT];
+
+/* Return the set of locks guarding a PA range, as a bitmask */
+static uint64_t gpt_range_lock_mask(uint64_t base, size_t size)
+{
+	uint64_t l0_idx = GPT_L0_IDX(base);
+	uint64_t last_l0_idx = GPT_L0_IDX(base + size - 1U);
+	uint64_t mask = 0ULL;
+
+	if ((last_l0_idx - l0_idx) >= (uint64_t)RME_GPT_LOCK_COUNT) {
+		return ~0ULL >> (64U - RME_GPT_LOCK_COUNT);
+	}
+
+	for (; l0_idx <= last_l0_idx; l0_idx++) {
+		mask |= 1ULL << (l0_idx & (RME_GPT_LOCK_COUNT - 1U));
+	}
+
+	return mask;
+}
+
+static void gpt_lock_range(uint64_t lock_mask)
+{
+	unsigned int i;
+
+	for (i = 0U; i < RME_GPT_LOCK_COUNT; i++) {
+		if ((lock_mask & (1ULL << i)) != 0ULL) {
+			spin_lock(&gpt_locks[i]);
+		}
+	}
+}
+
+static void gpt_unlock_range(uint64_t lock_mask)
+{
+	unsigned int i;
+
+	for (i = RME_GPT_LOCK_COUNT; i > 0U; i--) {
+		if ((lock_mask & (1ULL << (i - 1U))) != 0ULL) {
+			spin_unlock(&gpt_locks[i - 1U]);
+		}
+	}
+}
 
 /*
- * A helper to write the value (target_pas << gpi_shift) to the index of
- * the gpt_l1_addr
+ * TLBI RPALOS range sizes, from largest to smallest, and their encoding in
+ * the SIZE field of the operation.
  */
-static inline void write_gpt(uint64_t *gpt_l1_desc, uint64_t *gpt_l1_addr,
-			     unsigned int gpi_shift, unsigned int idx,
-			     unsigned int target_pas)
+static const struct {
+	unsigned int shift;
+	uint64_t enc;
+} gpt_tlbi_rpa_sizes[] = {
+	{ 39U, ULL(9) }, { 36U, ULL(8) }, { 34U, ULL(7) }, { 30U, ULL(6) },
+	{ 29U, ULL(5) }, { 25U, ULL(4) }, { 21U, ULL(3) }, { 16U, ULL(2) },
+	{ 14U, ULL(1) }, { 12U, ULL(0) }
+};
+
+/*
+ * Invalidate the cached GPT entries for a granule-aligned PA range, splitting
+ * it into the fewest naturally aligned blocks TLBI RPALOS can describe. The
+ * caller is responsible for the DSB that completes the invalidation.
+ */
+static void gpt_tlbi_by_pa_range(uint64_t base, size_t size)
 {
-	*gpt_l1_desc &= ~(GPT_L1_GRAN_DESC_GPI_MASK << gpi_shift);
-	*gpt_l1_desc |= ((uint64_t)target_pas << gpi_shift);
-	gpt_l1_addr[idx] = *gpt_l1_desc;
+	uint64_t pa = base;
+	uint64_t end = base + size;
+	unsigned int i;
+
+	while (pa < end) {
+		for (i = 0U; i < ARRAY_SIZE(gpt_tlbi_rpa_sizes) - 1U; i++) {
+			uint64_t blk = 1ULL << gpt_tlbi_rpa_sizes[i].shift;
+
+			if (((pa & (blk - 1ULL)) == 0ULL) &&
+			    ((end - pa) >= blk)) {
+				break;
+			}
+		}
+
+		tlbirpalos((pa >> FOUR_KB_SHIFT) |
+			   (gpt_tlbi_rpa_sizes[i].enc << GPT_TLBI_RPA_SIZE_SHIFT));
+		pa += 1ULL << gpt_tlbi_rpa_sizes[i].shift;
+	}
 }
 
 /*
- * Helper to retrieve the gpt_l1_* information from the base address
- * returned in gpi_info
+ * Helper to walk the L1 descriptors covering a granule-aligned PA range. It
+ * returns the address of the L1 descriptor holding the GPI of *pa, along with
+ * a mask of the GPIs in that descriptor which fall within the range, and
+ * advances *pa past them. Returns NULL if *pa is not covered by an L1 table.
  */
-static int get_gpi_params(uint64_t base, gpi_info_t *gpi_info)
+static uint64_t *gpt_next_l1_desc(uint64_t *pa, uint64_t end,
+				  uint64_t *gpi_mask)
 {
-	uint64_t gpt_l0_desc, *gpt_l0_base;
+	uint64_t gpt_l0_desc, *gpt_l0_base, *gpt_l1_desc;
+	unsigned int first, count;
 
 	gpt_l0_base = (uint64_t *)gpt_config.plat_gpt_l0_base;
-	gpt_l0_desc = gpt_l0_base[GPT_L0_IDX(base)];
+	gpt_l0_desc = gpt_l0_base[GPT_L0_IDX(*pa)];
 	if (GPT_L0_TYPE(gpt_l0_desc) != GPT_L0_TYPE_TBL_DESC) {
 		VERBOSE("[GPT] Granule is not covered by a table descriptor!\n");
-		VERBOSE("      Base=0x%" PRIx64 "\n", base);
-		return -EINVAL;
+		VERBOSE("      Base=0x%" PRIx64 "\n", *pa);
+		return NULL;
+	}
+
+	gpt_l1_desc = &GPT_L0_TBLD_ADDR(gpt_l0_desc)[GPT_L1_IDX(gpt_config.p,
+								 *pa)];
+
+	/* Number of GPIs from *pa to the end of the range or descriptor */
+	first = GPT_L1_GPI_IDX(gpt_config.p, *pa);
+	count = GPT_L1_GPI_PER_DESC - first;
+	if (((end - *pa) >> gpt_config.p) < count) {
+		count = (unsigned int)((end - *pa) >> gpt_config.p);
+	}
+
+	if (count == GPT_L1_GPI_PER_DESC) {
+		*gpi_mask = ~0ULL;
+	} else {
+		*gpi_mask = ((1ULL << (count << 2)) - 1ULL) << (first << 2);
 	}
 
-	/* Get the table index and GPI shift from PA. */
-	gpi_info->gpt_l1_addr = GPT_L0_TBLD_ADDR(gpt_l0_desc);
-	gpi_info->idx = GPT_L1_IDX(gpt_config.p, base);
-	gpi_info->gpi_shift = GPT_L1_GPI_IDX(gpt_config.p, base) << 2;
+	*pa += (uint64_t)count << gpt_config.p;
+
+	return gpt_l1_desc;
+}
+
+/*
+ * Check that every granule in a granule-aligned PA range is covered by an L1
+ * table and currently has the given GPI.
+ */
+static int gpt_check_range_gpi(uint64_t base, size_t size, unsigned int gpi)
+{
+	uint64_t pa = base;
+	uint64_t end = base + size;
+	uint64_t gpi_field = GPT_BUILD_L1_DESC(gpi);
+	uint64_t gpi_mask, *gpt_l1_desc;
+
+	while (pa < end) {
+		gpt_l1_desc = gpt_next_l1_desc(&pa, end, &gpi_mask);
+		if (gpt_l1_desc == NULL) {
+			return -EINVAL;
+		}
+
+		if (((*gpt_l1_desc ^ gpi_field) & gpi_mask) != 0ULL) {
+			return -EPERM;
+		}
+	}
 
-	gpi_info->gpt_l1_desc = (gpi_info->gpt_l1_addr)[gpi_info->idx];
-	gpi_info->gpi = (gpi_info->gpt_l1_desc >> gpi_info->gpi_shift) &
-		GPT_L1_GRAN_DESC_GPI_MASK;
 	return 0;
 }
 
+/*
+ * Set the GPI of every granule in a granule-aligned PA range, a whole L1
+ * descriptor at a time. The range must have been validated with
+ * gpt_check_range_gpi() beforehand.
+ */
+static void gpt_set_range_gpi(uint64_t base, size_t size, unsigned int gpi)
+{
+	uint64_t pa = base;
+	uint64_t end = base + size;
+	uint64_t gpi_field = GPT_BUILD_L1_DESC(gpi);
+	uint64_t gpi_mask, *gpt_l1_desc;
+
+	while (pa < end) {
+		gpt_l1_desc = gpt_next_l1_desc(&pa, end, &gpi_mask);
+		assert(gpt_l1_desc != NULL);
+
+		*gpt_l1_desc = (*gpt_l1_desc & ~gpi_mask) |
+			       (gpi_field & gpi_mask);
+	}
+}
+
 /*
  * This function is the granule transition delegate service. When a granule
  * transition request occurs it is routed to this function to have the request,
  * if valid, fulfilled following A1.1.1 Delegate of RME supplement
  *
- * TODO: implement support for transitioning multiple granules at once.
+ * Only a single granule is transitioned per request, which bounds the cache
+ * maintenance and TLB invalidation done while holding the GPT locks. The
+ * transition itself is written for a range of granules, for the day a caller
+ * needs one and a bound on its size is defined.
  *
  * Parameters
  *   base		Base address of the region to transition, must be
  *			aligned to granule size.
- *   size		Size of region to transition, must be aligned to granule
- *			size.
+ *   size		Size of region to transition, must be the granule size.
  *   src_sec_state	Security state of the caller.
  *
  * Return
@@ -1019,8 +1158,7 @@ static int get_gpi_params(uint64_t base, gpi_info_t *gpi_info)
  */
 int gpt_delegate_pas(uint64_t base, size_t size, unsigned int src_sec_state)
 {
-	gpi_info_t gpi_info;
-	uint64_t nse;
+	uint64_t nse, lock_mask;
 	int res;
 	unsigned int target_pas;
 
@@ -1034,7 +1172,7 @@ int gpt_delegate_pas(uint64_t base, size_t size, unsigned int src_sec_state)
 	assert(src_sec_state == SMC_FROM_REALM ||
 	       src_sec_state == SMC_FROM_SECURE);
 
-	/* See if this is a single or a range of granule transition. */
+	/* Only single granule transitions are supported */
 	if (size != GPT_PGS_ACTUAL_SIZE(gpt_config.p)) {
 		return -EINVAL;
 	}
@@ -1064,26 +1202,25 @@ int gpt_delegate_pas(uint64_t base, size_t size, unsigned int src_sec_state)
 	}
 
 	/*
-	 * Access to L1 tables is controlled by a global lock to ensure
-	 * that no more than one CPU is allowed to make changes at any
-	 * given time.
+	 * Access to L1 tables is controlled by the locks of the L0 regions
+	 * covered by the range, to ensure that no more than one CPU is allowed
+	 * to make changes to a given L1 table at any given time.
 	 */
-	spin_lock(&gpt_lock);
-	res = get_gpi_params(base, &gpi_info);
+	lock_mask = gpt_range_lock_mask(base, size);
+	gpt_lock_range(lock_mask);
+
+	/* Check that the whole range is in NS state */
+	res = gpt_check_range_gpi(base, size, GPT_GPI_NS);
 	if (res != 0) {
-		spin_unlock(&gpt_lock);
+		if (res == -EPERM) {
+			VERBOSE("[GPT] Only Granules in NS state can be delegated.\n");
+			VERBOSE("      Caller: %u, Base=0x%" PRIx64 ", Size=0x%lx\n",
+				src_sec_state, base, size);
+		}
+		gpt_unlock_range(lock_mask);
 		return res;
 	}
 
-	/* Check that the current address is in NS state */
-	if (gpi_info.gpi != GPT_GPI_NS) {
-		VERBOSE("[GPT] Only Granule in NS state can be delegated.\n");
-		VERBOSE("      Caller: %u, Current GPI: %u\n", src_sec_state,
-			gpi_info.gpi);
-		spin_unlock(&gpt_lock);
-		return -EPERM;
-	}
-
 	if (src_sec_state == SMC_FROM_SECURE) {
 		nse = (uint64_t)GPT_NSE_SECURE << GPT_NSE_SHIFT;
 	} else {
@@ -1095,30 +1232,27 @@ int gpt_delegate_pas(uint64_t base, size_t size, unsigned int src_sec_state)
 	 * states, remove any data speculatively fetched into the target
 	 * physical address space. Issue DC CIPAPA over address range
 	 */
-	flush_dcache_to_popa_range(nse | base,
-				   GPT_PGS_ACTUAL_SIZE(gpt_config.p));
+	flush_dcache_to_popa_range(nse | base, size);
 
-	write_gpt(&gpi_info.gpt_l1_desc, gpi_info.gpt_l1_addr,
-		  gpi_info.gpi_shift, gpi_info.idx, target_pas);
+	gpt_set_range_gpi(base, size, target_pas);
 	dsboshst();
 
-	gpt_tlbi_by_pa_ll(base, GPT_PGS_ACTUAL_SIZE(gpt_config.p));
+	gpt_tlbi_by_pa_range(base, size);
 	dsbosh();
 
 	nse = (uint64_t)GPT_NSE_NS << GPT_NSE_SHIFT;
 
-	flush_dcache_to_popa_range(nse | base,
-				   GPT_PGS_ACTUAL_SIZE(gpt_config.p));
+	flush_dcache_to_popa_range(nse | base, size);
 
 	/* Unlock access to the L1 tables. */
-	spin_unlock(&gpt_lock);
+	gpt_unlock_range(lock_mask);
 
 	/*
 	 * The isb() will be done as part of context
 	 * synchronization when returning to lower EL
 	 */
-	VERBOSE("[GPT] Granule 0x%" PRIx64 ", GPI 0x%x->0x%x\n",
-		base, gpi_info.gpi, target_pas);
+	VERBOSE("[GPT] Granules 0x%" PRIx64 "-0x%" PRIx64 ", GPI 0x%x->0x%x\n",
+		base, base + size - 1U, GPT_GPI_NS, target_pas);
 
 	return 0;
 }
@@ -1128,13 +1262,12 @@ int gpt_delegate_pas(uint64_t base, size_t size, unsigned int src_sec_state)
  * transition request occurs it is routed to this function where the request is
  * validated then fulfilled if possible.
  *
- * TODO: implement support for transitioning multiple granules at once.
+ * As for delegation, only a single granule is transitioned per request.
  *
  * Parameters
  *   base		Base address of the region to transition, must be
  *			aligned to granule size.
- *   size		Size of region to transition, must be aligned to granule
- *			size.
+ *   size		Size of region to transition, must be the granule size.
  *   src_sec_state	Security state of the caller.
  *
  * Return
@@ -1142,9 +1275,9 @@ int gpt_delegate_pas(uint64_t base, size_t size, unsigned int src_sec_state)
  */
 int gpt_undelegate_pas(uint64_t base, size_t size, unsigned int src_sec_state)
 {
-	gpi_info_t gpi_info;
-	uint64_t nse;
+	uint64_t nse, lock_mask;
 	int res;
+	unsigned int src_pas;
 
 	/* Ensure that the tables have been set up before taking requests. */
 	assert(gpt_config.plat_gpt_l0_base != 0UL);
@@ -1156,7 +1289,7 @@ int gpt_undelegate_pas(uint64_t base, size_t size, unsigned int src_sec_state)
 	assert(src_sec_state == SMC_FROM_REALM ||
 	       src_sec_state == SMC_FROM_SECURE);
 
-	/* See if this is a single or a range of granule transition. */
+	/* Only single granule transitions are supported */
 	if (size != GPT_PGS_ACTUAL_SIZE(gpt_config.p)) {
 		return -EINVAL;
 	}
@@ -1180,42 +1313,40 @@ int gpt_undelegate_pas(uint64_t base, size_t size, unsigned int src_sec_state)
 		return -EINVAL;
 	}
 
+	src_pas = GPT_GPI_REALM;
+	if (src_sec_state == SMC_FROM_SECURE) {
+		src_pas = GPT_GPI_SECURE;
+	}
+
 	/*
-	 * Access to L1 tables is controlled by a global lock to ensure
-	 * that no more than one CPU is allowed to make changes at any
-	 * given time.
+	 * Access to L1 tables is controlled by the locks of the L0 regions
+	 * covered by the range, to ensure that no more than one CPU is allowed
+	 * to make changes to a given L1 table at any given time.
 	 */
-	spin_lock(&gpt_lock);
+	lock_mask = gpt_range_lock_mask(base, size);
+	gpt_lock_range(lock_mask);
 
-	res = get_gpi_params(base, &gpi_info);
+	/* Check that the whole range is in the delegated state */
+	res = gpt_check_range_gpi(base, size, src_pas);
 	if (res != 0) {
-		spin_unlock(&gpt_lock);
+		if (res == -EPERM) {
+			VERBOSE("[GPT] Only Granules in REALM or SECURE state can be undelegated.\n");
+			VERBOSE("      Caller: %u, Base=0x%" PRIx64 ", Size=0x%lx\n",
+				src_sec_state, base, size);
+		}
+		gpt_unlock_range(lock_mask);
 		return res;
 	}
 
-	/* Check that the current address is in the delegated state */
-	if ((src_sec_state == SMC_FROM_REALM  &&
-	     gpi_info.gpi != GPT_GPI_REALM) ||
-	    (src_sec_state == SMC_FROM_SECURE &&
-	     gpi_info.gpi != GPT_GPI_SECURE)) {
-		VERBOSE("[GPT] Only Granule in REALM or SECURE state can be undelegated.\n");
-		VERBOSE("      Caller: %u, Current GPI: %u\n", src_sec_state,
-			gpi_info.gpi);
-		spin_unlock(&gpt_lock);
-		return -EPERM;
-	}
-
-
 	/* In order to maintain mutual distrust between Realm and Secure
 	 * states, remove access now, in order to guarantee that writes
 	 * to the currently-accessible physical address space will not
 	 * later become observable.
 	 */
-	write_gpt(&gpi_info.gpt_l1_desc, gpi_info.gpt_l1_addr,
-		  gpi_info.gpi_shift, gpi_info.idx, GPT_GPI_NO_ACCESS);
+	gpt_set_range_gpi(base, size, GPT_GPI_NO_ACCESS);
 	dsboshst();
 
-	gpt_tlbi_by_pa_ll(base, GPT_PGS_ACTUAL_SIZE(gpt_config.p));
+	gpt_tlbi_by_pa_range(base, size);
 	dsbosh();
 
 	if (src_sec_state == SMC_FROM_SECURE) {
@@ -1225,8 +1356,7 @@ int gpt_undelegate_pas(uint64_t base, size_t size, unsigned int src_sec_state)
 	}
 
 	/* Ensure that the scrubbed data has made it past the PoPA */
-	flush_dcache_to_popa_range(nse | base,
-				   GPT_PGS_ACTUAL_SIZE(gpt_config.p));
+	flush_dcache_to_popa_range(nse | base, size);
 
 	/*
 	 * Remove any data loaded speculatively
@@ -1234,27 +1364,25 @@ int gpt_undelegate_pas(uint64_t base, size_t size, unsigned int src_sec_state)
 	 */
 	nse = (uint64_t)GPT_NSE_NS << GPT_NSE_SHIFT;
 
-	flush_dcache_to_popa_range(nse | base,
-				   GPT_PGS_ACTUAL_SIZE(gpt_config.p));
+	flush_dcache_to_popa_range(nse | base, size);
 
-	/* Clear existing GPI encoding and transition granule. */
-	write_gpt(&gpi_info.gpt_l1_desc, gpi_info.gpt_l1_addr,
-		  gpi_info.gpi_shift, gpi_info.idx, GPT_GPI_NS);
+	/* Clear existing GPI encoding and transition granules. */
+	gpt_set_range_gpi(base, size, GPT_GPI_NS);
 	dsboshst();
 
 	/* Ensure that all agents observe the new NS configuration */
-	gpt_tlbi_by_pa_ll(base, GPT_PGS_ACTUAL_SIZE(gpt_config.p));
+	gpt_tlbi_by_pa_range(base, size);
 	dsbosh();
 
 	/* Unlock access to the L1 tables. */
-	spin_unlock(&gpt_lock);
+	gpt_unlock_range(lock_mask);
 
 	/*
 	 * The isb() will be done as part of context
 	 * synchronization when returning to lower EL
 	 */
-	VERBOSE("[GPT] Granule 0x%" PRIx64 ", GPI 0x%x->0x%x\n",
-		base, gpi_info.gpi, GPT_GPI_NS);
+	VERBOSE("[GPT] Granules 0x%" PRIx64 "-0x%" PRIx64 ", GPI 0x%x->0x%x\n",
+		base, base + size - 1U, src_pas, GPT_GPI_NS);
 
 	return 0;
 }
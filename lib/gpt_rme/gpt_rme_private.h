@@ -106,17 +106,6 @@ typedef enum {
 	PGS_64KB_P =	16U
 } gpt_p_val_e;
 
-/*
- * Internal structure to retrieve the values from get_gpi_info();
- */
-typedef struct gpi_info {
-	uint64_t gpt_l1_desc;
-	uint64_t *gpt_l1_addr;
-	unsigned int idx;
-	unsigned int gpi_shift;
-	unsigned int gpi;
-} gpi_info_t;
-
 /* Max valid value for PGS. */
 #define GPT_PGS_MAX			(2U)
 
@@ -250,10 +239,16 @@ typedef struct gpi_info {
 #define GPT_L1_IDX(_p, _pa)	(((_pa) >> GPT_L1_IDX_SHIFT(_p)) & \
 				GPT_L1_IDX_MASK(_p))
 
+/* Number of GPIs held in each L1 table entry. */
+#define GPT_L1_GPI_PER_DESC	(GPT_L1_GPI_IDX_MASK + 1U)
+
 /* Get the index of the GPI within an L1 table entry from a physical address. */
 #define GPT_L1_GPI_IDX(_p, _pa)	(((_pa) >> GPT_L1_GPI_IDX_SHIFT(_p)) & \
 				GPT_L1_GPI_IDX_MASK)
 
+/* Bit shift for the SIZE field of the TLBI RPALOS operand. */
+#define GPT_TLBI_RPA_SIZE_SHIFT	U(44)
+
 /* Determine if an address is granule-aligned. */
 #define GPT_IS_L1_ALIGNED(_p, _pa) (((_pa) & (GPT_PGS_ACTUAL_SIZE(_p) - U(1))) \
 				   == U(0))
@@ -36,6 +36,18 @@ LIBC_SRCS	:=	$(addprefix lib/libc/,		\
 ifeq (${ARCH},aarch64)
 LIBC_SRCS	+=	$(addprefix lib/libc/aarch64/,	\
 			setjmp.S)
+
+# Word-at-a-time AArch64 versions of the string and memory routines
+ifeq (${LIBC_ASM_STRING},1)
+LIBC_SRCS	:=	$(filter-out $(addprefix lib/libc/,	\
+				memcmp.c memcpy.c memmove.c strlen.c),	\
+			$(LIBC_SRCS))
+LIBC_SRCS	+=	$(addprefix lib/libc/aarch64/,	\
+			memcmp.S			\
+			memcpy.S			\
+			memmove.S			\
+			strlen.S)
+endif
 endif
 
 INCLUDES	+=	-Iinclude/lib/libc		\
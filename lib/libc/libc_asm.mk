@@ -35,6 +35,18 @@ ifeq (${ARCH},aarch64)
 LIBC_SRCS	+=	$(addprefix lib/libc/aarch64/,	\
 			memset.S			\
 			setjmp.S)
+
+# Word-at-a-time AArch64 versions of the string and memory routines
+ifeq (${LIBC_ASM_STRING},1)
+LIBC_SRCS	:=	$(filter-out $(addprefix lib/libc/,	\
+				memcmp.c memcpy.c memmove.c strlen.c),	\
+			$(LIBC_SRCS))
+LIBC_SRCS	+=	$(addprefix lib/libc/aarch64/,	\
+			memcmp.S			\
+			memcpy.S			\
+			memmove.S			\
+			strlen.S)
+endif
 else
 LIBC_SRCS	+=	$(addprefix lib/libc/aarch32/,	\
 			memset.S)
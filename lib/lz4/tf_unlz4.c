@@ -0,0 +1,697 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Decoder for the LZ4 frame format, as produced by the lz4 command line tool.
+ * See https://github.com/lz4/lz4/blob/dev/doc/lz4_Frame_format.md and
+ * https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <common/debug.h>
+#include <lib/utils_def.h>
+#include <tf_unlz4.h>
+
+#define LZ4_MAGIC			0x184D2204U
+#define LZ4_SKIPPABLE_MAGIC		0x184D2A50U
+#define LZ4_SKIPPABLE_MAGIC_MASK	0xFFFFFFF0U
+
+/* Frame descriptor FLG byte */
+#define LZ4_FLG_VERSION_SHIFT		6U
+#define LZ4_FLG_VERSION_MASK		0x3U
+#define LZ4_FLG_VERSION			0x1U
+#define LZ4_FLG_BLOCK_CHECKSUM		(1U << 4)
+#define LZ4_FLG_CONTENT_SIZE		(1U << 3)
+#define LZ4_FLG_CONTENT_CHECKSUM	(1U << 2)
+#define LZ4_FLG_RESERVED		(1U << 1)
+#define LZ4_FLG_DICT_ID			(1U << 0)
+
+/* Frame descriptor BD byte */
+#define LZ4_BD_BLOCK_MAX_SHIFT		4U
+#define LZ4_BD_BLOCK_MAX_MASK		0x7U
+#define LZ4_BD_RESERVED			0x8FU
+
+#define LZ4_BLOCK_UNCOMPRESSED		(1U << 31)
+#define LZ4_MIN_MATCH			4U
+#define LZ4_LEN_MASK			0xFU
+
+/* xxHash32 primes */
+#define XXH_PRIME32_1			2654435761U
+#define XXH_PRIME32_2			2246822519U
+#define XXH_PRIME32_3			3266489917U
+#define XXH_PRIME32_4			668265263U
+#define XXH_PRIME32_5			374761393U
+
+static uint32_t read_le32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+	       ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint32_t rotl32(uint32_t x, unsigned int r)
+{
+	return (x << r) | (x >> (32U - r));
+}
+
+static uint32_t xxh32_round(uint32_t acc, uint32_t input)
+{
+	return rotl32(acc + input * XXH_PRIME32_2, 13) * XXH_PRIME32_1;
+}
+
+/* xxHash32 with a seed of 0, as used for all LZ4 frame checksums */
+static uint32_t xxh32(const uint8_t *p, size_t len)
+{
+	const uint8_t *end = p + len;
+	uint32_t v1, v2, v3, v4;
+	uint32_t h;
+
+	if (len >= 16U) {
+		v1 = XXH_PRIME32_1 + XXH_PRIME32_2;
+		v2 = XXH_PRIME32_2;
+		v3 = 0U;
+		v4 = 0U - XXH_PRIME32_1;
+
+		for (; (end - p) >= 16; p += 16) {
+			v1 = xxh32_round(v1, read_le32(p));
+			v2 = xxh32_round(v2, read_le32(p + 4));
+			v3 = xxh32_round(v3, read_le32(p + 8));
+			v4 = xxh32_round(v4, read_le32(p + 12));
+		}
+
+		h = rotl32(v1, 1) + rotl32(v2, 7) + rotl32(v3, 12) +
+		    rotl32(v4, 18);
+	} else {
+		h = XXH_PRIME32_5;
+	}
+
+	h += (uint32_t)len;
+
+	for (; (end - p) >= 4; p += 4) {
+		h += read_le32(p) * XXH_PRIME32_3;
+		h = rotl32(h, 17) * XXH_PRIME32_4;
+	}
+
+	for (; p < end; p++) {
+		h += *p * XXH_PRIME32_5;
+		h = rotl32(h, 11) * XXH_PRIME32_1;
+	}
+
+	h ^= h >> 15;
+	h *= XXH_PRIME32_2;
+	h ^= h >> 13;
+	h *= XXH_PRIME32_3;
+	h ^= h >> 16;
+
+	return h;
+}
+
+/* Add the extra bytes of a literal or match length to 'len' */
+static int lz4_read_len(const uint8_t **in, const uint8_t *in_end, size_t *len)
+{
+	unsigned int b;
+
+	do {
+		if (*in == in_end) {
+			return -EIO;
+		}
+		b = *(*in)++;
+		*len += b;
+	} while (b == 255U);
+
+	return 0;
+}
+
+/*
+ * Decode an LZ4 compressed block to 'out'. Matches may refer to any output
+ * since 'out_start', so that blocks linked to previous ones can be decoded.
+ */
+static int lz4_decode_block(const uint8_t *in, size_t in_len,
+			    uint8_t *out_start, uint8_t **out,
+			    const uint8_t *out_end)
+{
+	const uint8_t *in_end = in + in_len;
+	const uint8_t *match;
+	uint8_t *op = *out;
+	size_t lit_len, match_len, offset;
+	unsigned int token;
+
+	while (in < in_end) {
+		token = *in++;
+
+		lit_len = token >> 4;
+		if ((lit_len == LZ4_LEN_MASK) &&
+		    (lz4_read_len(&in, in_end, &lit_len) != 0)) {
+			return -EIO;
+		}
+		if ((lit_len > (size_t)(in_end - in)) ||
+		    (lit_len > (size_t)(out_end - op))) {
+			return -EIO;
+		}
+		(void)memcpy(op, in, lit_len);
+		op += lit_len;
+		in += lit_len;
+
+		/* The last sequence of a block only has literals */
+		if (in == in_end) {
+			break;
+		}
+
+		if ((in_end - in) < 2) {
+			return -EIO;
+		}
+		offset = (size_t)in[0] | ((size_t)in[1] << 8);
+		in += 2;
+		if ((offset == 0U) || (offset > (size_t)(op - out_start))) {
+			return -EIO;
+		}
+
+		match_len = token & LZ4_LEN_MASK;
+		if ((match_len == LZ4_LEN_MASK) &&
+		    (lz4_read_len(&in, in_end, &match_len) != 0)) {
+			return -EIO;
+		}
+		match_len += LZ4_MIN_MATCH;
+		if (match_len > (size_t)(out_end - op)) {
+			return -EIO;
+		}
+
+		/*
+		 * A match may overlap the output it produces, in which case it
+		 * repeats the last 'offset' bytes.
+		 */
+		match = op - offset;
+		if (offset >= match_len) {
+			(void)memcpy(op, match, match_len);
+			op += match_len;
+		} else {
+			if (offset >= 8U) {
+				for (; match_len >= 8U; match_len -= 8U) {
+					(void)memcpy(op, match, 8U);
+					op += 8;
+					match += 8;
+				}
+			}
+			for (; match_len > 0U; match_len--) {
+				*op++ = *match++;
+			}
+		}
+	}
+
+	*out = op;
+
+	return 0;
+}
+
+/* Parameters of an LZ4 frame, from its frame descriptor */
+struct lz4_frame {
+	unsigned int flg;
+	uint32_t block_max;
+	uint64_t content_size;
+};
+
+/* Length of the frame descriptor starting with 'flg', checksum included */
+static size_t lz4_desc_len(unsigned int flg)
+{
+	return ((flg & LZ4_FLG_CONTENT_SIZE) != 0U) ? 11U : 3U;
+}
+
+/*
+ * Check the 'desc_len' byte frame descriptor at 'desc', for output to a buffer
+ * of 'out_len' bytes, and fill in 'frame' from it.
+ */
+static int lz4_parse_desc(const uint8_t *desc, size_t desc_len,
+			  size_t out_len, struct lz4_frame *frame)
+{
+	unsigned int flg = desc[0];
+	unsigned int bd = desc[1];
+
+	if ((((flg >> LZ4_FLG_VERSION_SHIFT) & LZ4_FLG_VERSION_MASK) !=
+	     LZ4_FLG_VERSION) || ((flg & LZ4_FLG_RESERVED) != 0U) ||
+	    ((bd & LZ4_BD_RESERVED) != 0U) ||
+	    (((bd >> LZ4_BD_BLOCK_MAX_SHIFT) & LZ4_BD_BLOCK_MAX_MASK) < 4U)) {
+		ERROR("lz4: unsupported frame descriptor 0x%x 0x%x\n", flg, bd);
+		return -EIO;
+	}
+	if ((flg & LZ4_FLG_DICT_ID) != 0U) {
+		ERROR("lz4: dictionaries are not supported\n");
+		return -EIO;
+	}
+	if (desc[desc_len - 1U] !=
+	    ((xxh32(desc, desc_len - 1U) >> 8) & 0xFFU)) {
+		ERROR("lz4: bad frame descriptor checksum\n");
+		return -EIO;
+	}
+
+	frame->flg = flg;
+	frame->block_max = 1U << (8U + 2U * ((bd >> LZ4_BD_BLOCK_MAX_SHIFT) &
+					     LZ4_BD_BLOCK_MAX_MASK));
+	frame->content_size = 0U;
+	if ((flg & LZ4_FLG_CONTENT_SIZE) != 0U) {
+		frame->content_size = (uint64_t)read_le32(desc + 2) |
+				      ((uint64_t)read_le32(desc + 6) << 32);
+		if (frame->content_size > out_len) {
+			ERROR("lz4: output of %llu bytes does not fit\n",
+			      (unsigned long long)frame->content_size);
+			return -EIO;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Check a block header and return the size of the block data in 'block_size'
+ * and whether it is stored uncompressed in 'uncompressed'.
+ */
+static int lz4_parse_block_size(const struct lz4_frame *frame,
+				const uint8_t *hdr, uint32_t *block_size,
+				bool *uncompressed)
+{
+	uint32_t size = read_le32(hdr);
+
+	*uncompressed = (size & LZ4_BLOCK_UNCOMPRESSED) != 0U;
+	size &= ~LZ4_BLOCK_UNCOMPRESSED;
+	if (size > frame->block_max) {
+		ERROR("lz4: bad block size %u\n", size);
+		return -EIO;
+	}
+
+	*block_size = size;
+
+	return 0;
+}
+
+/* Length of the block checksum following the data of each block, if any */
+static size_t lz4_block_checksum_len(const struct lz4_frame *frame)
+{
+	return ((frame->flg & LZ4_FLG_BLOCK_CHECKSUM) != 0U) ? 4U : 0U;
+}
+
+/*
+ * Decode the 'block_size' bytes of block data at 'in' to 'out', after checking
+ * the block checksum that follows them if the frame has one.
+ */
+static int lz4_block(const struct lz4_frame *frame, const uint8_t *in,
+		     uint32_t block_size, bool uncompressed,
+		     uint8_t *out_start, uint8_t **out, const uint8_t *out_end)
+{
+	if ((lz4_block_checksum_len(frame) != 0U) &&
+	    (read_le32(in + block_size) != xxh32(in, block_size))) {
+		ERROR("lz4: bad block checksum\n");
+		return -EIO;
+	}
+
+	if (uncompressed) {
+		if (block_size > (size_t)(out_end - *out)) {
+			ERROR("lz4: output does not fit\n");
+			return -EIO;
+		}
+		(void)memcpy(*out, in, block_size);
+		*out += block_size;
+	} else if (lz4_decode_block(in, block_size, out_start, out,
+				    out_end) != 0) {
+		ERROR("lz4: corrupted block\n");
+		return -EIO;
+	}
+
+	return 0;
+}
+
+/* Check the end of a frame, once the output is complete */
+static int lz4_frame_end(const struct lz4_frame *frame,
+			 const uint8_t *checksum, const uint8_t *out_start,
+			 const uint8_t *out)
+{
+	size_t len = out - out_start;
+
+	if ((checksum != NULL) &&
+	    (read_le32(checksum) != xxh32(out_start, len))) {
+		ERROR("lz4: bad content checksum\n");
+		return -EIO;
+	}
+
+	if (((frame->flg & LZ4_FLG_CONTENT_SIZE) != 0U) &&
+	    (frame->content_size != (uint64_t)len)) {
+		ERROR("lz4: content size mismatch\n");
+		return -EIO;
+	}
+
+	return 0;
+}
+
+/*
+ * unlz4 - decompress LZ4 frame data
+ * @in_buf: source of compressed input. Upon exit, the end of input.
+ * @in_len: length of in_buf
+ * @out_buf: destination of decompressed output. Upon exit, the end of output.
+ * @out_len: length of out_buf
+ * @work_buf: workspace (unused)
+ * @work_len: length of workspace (unused)
+ *
+ * Leading skippable frames are ignored, and so is anything following the first
+ * LZ4 frame. Block and content checksums are verified when the frame has them.
+ */
+int unlz4(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
+	  size_t out_len, uintptr_t work_buf, size_t work_len)
+{
+	const uint8_t *in = (const uint8_t *)*in_buf;
+	const uint8_t *in_end = in + in_len;
+	const uint8_t *checksum = NULL;
+	uint8_t *out_start = (uint8_t *)*out_buf;
+	uint8_t *op = out_start;
+	const uint8_t *out_end = out_start + out_len;
+	struct lz4_frame frame;
+	uint32_t magic, block_size;
+	size_t desc_len, data_len;
+	bool uncompressed;
+
+	/* Skip any skippable frames */
+	for (;;) {
+		if ((in_end - in) < 4) {
+			ERROR("lz4: truncated input\n");
+			return -EIO;
+		}
+		magic = read_le32(in);
+		if ((magic & LZ4_SKIPPABLE_MAGIC_MASK) != LZ4_SKIPPABLE_MAGIC) {
+			break;
+		}
+		if (((in_end - in) < 8) ||
+		    (read_le32(in + 4) > (size_t)(in_end - in - 8))) {
+			ERROR("lz4: truncated input\n");
+			return -EIO;
+		}
+		in += 8 + read_le32(in + 4);
+	}
+
+	if (magic != LZ4_MAGIC) {
+		ERROR("lz4: bad magic number 0x%x\n", magic);
+		return -EIO;
+	}
+	in += 4;
+
+	/* Frame descriptor */
+	if (in == in_end) {
+		ERROR("lz4: truncated input\n");
+		return -EIO;
+	}
+	desc_len = lz4_desc_len(in[0]);
+	if ((size_t)(in_end - in) < desc_len) {
+		ERROR("lz4: truncated input\n");
+		return -EIO;
+	}
+	if (lz4_parse_desc(in, desc_len, out_len, &frame) != 0) {
+		return -EIO;
+	}
+	in += desc_len;
+
+	/* Data blocks, up to the end mark */
+	for (;;) {
+		if ((in_end - in) < 4) {
+			ERROR("lz4: truncated input\n");
+			return -EIO;
+		}
+		if (read_le32(in) == 0U) {
+			in += 4;
+			break;
+		}
+		if (lz4_parse_block_size(&frame, in, &block_size,
+					 &uncompressed) != 0) {
+			return -EIO;
+		}
+		in += 4;
+
+		data_len = block_size + lz4_block_checksum_len(&frame);
+		if (data_len > (size_t)(in_end - in)) {
+			ERROR("lz4: truncated input\n");
+			return -EIO;
+		}
+		if (lz4_block(&frame, in, block_size, uncompressed, out_start,
+			      &op, out_end) != 0) {
+			return -EIO;
+		}
+		in += data_len;
+	}
+
+	if ((frame.flg & LZ4_FLG_CONTENT_CHECKSUM) != 0U) {
+		if ((in_end - in) < 4) {
+			ERROR("lz4: truncated input\n");
+			return -EIO;
+		}
+		checksum = in;
+		in += 4;
+	}
+
+	if (lz4_frame_end(&frame, checksum, out_start, op) != 0) {
+		return -EIO;
+	}
+
+	VERBOSE("lz4: %lu byte input\n",
+		(unsigned long)((uintptr_t)in - *in_buf));
+	VERBOSE("lz4: %lu byte output\n", (unsigned long)(op - out_start));
+
+	*in_buf = (uintptr_t)in;
+	*out_buf = (uintptr_t)op;
+
+	return 0;
+}
+
+/* What the streaming decoder expects next */
+enum lz4_stream_state {
+	LZ4_STREAM_MAGIC,
+	LZ4_STREAM_SKIP_SIZE,
+	LZ4_STREAM_SKIP,
+	LZ4_STREAM_FLG,
+	LZ4_STREAM_DESC,
+	LZ4_STREAM_BLOCK_SIZE,
+	LZ4_STREAM_BLOCK,
+	LZ4_STREAM_CONTENT_CHECKSUM,
+	LZ4_STREAM_DONE,
+};
+
+/*
+ * State of the streaming decoder. Each field of the frame is gathered in 'hdr'
+ * and each block in the workspace until it is complete, then it is handled.
+ * Blocks are decoded straight to the output, where any earlier output they
+ * refer to already is.
+ */
+static struct {
+	enum lz4_stream_state state;
+	struct lz4_frame frame;
+	uint8_t hdr[11];		/* Fits a frame descriptor */
+	uint8_t *buf;			/* Field destination or NULL */
+	size_t need;			/* Length of the field */
+	size_t have;			/* Bytes of the field gathered so far */
+	uint32_t block_size;
+	bool uncompressed;
+	uint8_t *work;
+	size_t work_len;
+	size_t in_total;
+	uint8_t *out_start;
+	uint8_t *out;
+	const uint8_t *out_end;
+} lz4_strm;
+
+static void lz4_stream_expect(enum lz4_stream_state state, uint8_t *buf,
+			      size_t need)
+{
+	lz4_strm.state = state;
+	lz4_strm.buf = buf;
+	lz4_strm.need = need;
+	lz4_strm.have = 0U;
+}
+
+/* Handle the field that has just been gathered */
+static int lz4_stream_step(void)
+{
+	uint32_t magic;
+	size_t need;
+
+	switch (lz4_strm.state) {
+	case LZ4_STREAM_MAGIC:
+		magic = read_le32(lz4_strm.hdr);
+		if ((magic & LZ4_SKIPPABLE_MAGIC_MASK) == LZ4_SKIPPABLE_MAGIC) {
+			lz4_stream_expect(LZ4_STREAM_SKIP_SIZE, lz4_strm.hdr,
+					  4U);
+			break;
+		}
+		if (magic != LZ4_MAGIC) {
+			ERROR("lz4: bad magic number 0x%x\n", magic);
+			return -EIO;
+		}
+		lz4_stream_expect(LZ4_STREAM_FLG, lz4_strm.hdr, 1U);
+		break;
+
+	case LZ4_STREAM_SKIP_SIZE:
+		lz4_stream_expect(LZ4_STREAM_SKIP, NULL,
+				  read_le32(lz4_strm.hdr));
+		break;
+
+	case LZ4_STREAM_SKIP:
+		lz4_stream_expect(LZ4_STREAM_MAGIC, lz4_strm.hdr, 4U);
+		break;
+
+	case LZ4_STREAM_FLG:
+		/* Gather the rest of the frame descriptor after FLG */
+		lz4_strm.state = LZ4_STREAM_DESC;
+		lz4_strm.need = lz4_desc_len(lz4_strm.hdr[0]);
+		break;
+
+	case LZ4_STREAM_DESC:
+		if (lz4_parse_desc(lz4_strm.hdr, lz4_strm.need,
+				   lz4_strm.out_end - lz4_strm.out_start,
+				   &lz4_strm.frame) != 0) {
+			return -EIO;
+		}
+		need = lz4_strm.frame.block_max +
+		       lz4_block_checksum_len(&lz4_strm.frame);
+		if (need > lz4_strm.work_len) {
+			ERROR("lz4: %u byte blocks do not fit the workspace\n",
+			      lz4_strm.frame.block_max);
+			return -ENOMEM;
+		}
+		lz4_stream_expect(LZ4_STREAM_BLOCK_SIZE, lz4_strm.hdr, 4U);
+		break;
+
+	case LZ4_STREAM_BLOCK_SIZE:
+		if (read_le32(lz4_strm.hdr) == 0U) {
+			if ((lz4_strm.frame.flg & LZ4_FLG_CONTENT_CHECKSUM) !=
+			    0U) {
+				lz4_stream_expect(LZ4_STREAM_CONTENT_CHECKSUM,
+						  lz4_strm.hdr, 4U);
+			} else {
+				lz4_strm.state = LZ4_STREAM_DONE;
+			}
+			break;
+		}
+		if (lz4_parse_block_size(&lz4_strm.frame, lz4_strm.hdr,
+					 &lz4_strm.block_size,
+					 &lz4_strm.uncompressed) != 0) {
+			return -EIO;
+		}
+		lz4_stream_expect(LZ4_STREAM_BLOCK, lz4_strm.work,
+				  lz4_strm.block_size +
+				  lz4_block_checksum_len(&lz4_strm.frame));
+		break;
+
+	case LZ4_STREAM_BLOCK:
+		if (lz4_block(&lz4_strm.frame, lz4_strm.work,
+			      lz4_strm.block_size, lz4_strm.uncompressed,
+			      lz4_strm.out_start, &lz4_strm.out,
+			      lz4_strm.out_end) != 0) {
+			return -EIO;
+		}
+		lz4_stream_expect(LZ4_STREAM_BLOCK_SIZE, lz4_strm.hdr, 4U);
+		break;
+
+	case LZ4_STREAM_CONTENT_CHECKSUM:
+		if (lz4_frame_end(&lz4_strm.frame, lz4_strm.hdr,
+				  lz4_strm.out_start, lz4_strm.out) != 0) {
+			return -EIO;
+		}
+		lz4_strm.state = LZ4_STREAM_DONE;
+		break;
+
+	default:
+		break;
+	}
+
+	return 0;
+}
+
+/*
+ * unlz4_stream_init - start decompressing LZ4 frame data fed in pieces
+ * @out_buf: destination of decompressed output
+ * @out_len: length of out_buf
+ * @work_buf: workspace, which holds one block of the frame and its checksum
+ * @work_len: length of workspace
+ */
+static int unlz4_stream_init(uintptr_t out_buf, size_t out_len,
+			     uintptr_t work_buf, size_t work_len)
+{
+	(void)memset(&lz4_strm, 0, sizeof(lz4_strm));
+	lz4_strm.work = (uint8_t *)work_buf;
+	lz4_strm.work_len = work_len;
+	lz4_strm.out_start = (uint8_t *)out_buf;
+	lz4_strm.out = lz4_strm.out_start;
+	lz4_strm.out_end = lz4_strm.out_start + out_len;
+	lz4_stream_expect(LZ4_STREAM_MAGIC, lz4_strm.hdr, 4U);
+
+	return 0;
+}
+
+/*
+ * unlz4_stream_feed - decompress the next piece of LZ4 frame data
+ * @in_buf: compressed input
+ * @in_len: length of in_buf
+ *
+ * Anything following the first LZ4 frame is ignored.
+ */
+static int unlz4_stream_feed(uintptr_t in_buf, size_t in_len)
+{
+	const uint8_t *in = (const uint8_t *)in_buf;
+	size_t len;
+	int ret;
+
+	while (lz4_strm.state != LZ4_STREAM_DONE) {
+		if (lz4_strm.have == lz4_strm.need) {
+			ret = lz4_stream_step();
+			if (ret != 0) {
+				return ret;
+			}
+			continue;
+		}
+
+		if (in_len == 0U) {
+			break;
+		}
+
+		len = MIN(lz4_strm.need - lz4_strm.have, in_len);
+		if (lz4_strm.buf != NULL) {
+			(void)memcpy(lz4_strm.buf + lz4_strm.have, in, len);
+		}
+		lz4_strm.have += len;
+		lz4_strm.in_total += len;
+		in += len;
+		in_len -= len;
+	}
+
+	return 0;
+}
+
+/*
+ * unlz4_stream_end - complete decompressing LZ4 frame data
+ * @out_buf: upon exit, the end of output
+ */
+static int unlz4_stream_end(uintptr_t *out_buf)
+{
+	int ret = 0;
+
+	if (lz4_strm.state != LZ4_STREAM_DONE) {
+		ERROR("lz4: truncated input\n");
+		ret = -EIO;
+	} else if ((lz4_strm.frame.flg & LZ4_FLG_CONTENT_CHECKSUM) == 0U) {
+		/* Else checked with the content checksum */
+		ret = lz4_frame_end(&lz4_strm.frame, NULL, lz4_strm.out_start,
+				    lz4_strm.out);
+	}
+
+	VERBOSE("lz4: %lu byte input\n", (unsigned long)lz4_strm.in_total);
+	VERBOSE("lz4: %lu byte output\n",
+		(unsigned long)(lz4_strm.out - lz4_strm.out_start));
+
+	*out_buf = (uintptr_t)lz4_strm.out;
+
+	return ret;
+}
+
+const decompressor_stream_t unlz4_stream = {
+	.init = unlz4_stream_init,
+	.feed = unlz4_stream_feed,
+	.end = unlz4_stream_end,
+};
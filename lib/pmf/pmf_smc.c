@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2018, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -11,6 +11,13 @@
 #include <plat/common/platform.h>
 #include <smccc_helpers.h>
 
+#if ENABLE_SMC_STATS
+/* Histogram buckets 'i' and 'i + 1' packed in a register */
+#define SMC_STATS_HIST(_stats, _i)					\
+	((((u_register_t)(_stats).hist[(_i) + 1]) << 32) |		\
+	 (u_register_t)(_stats).hist[(_i)])
+#endif
+
 /*
  * This function is responsible for handling all PMF SMC calls.
  */
@@ -25,6 +32,9 @@ uintptr_t pmf_smc_handler(unsigned int smc_fid,
 {
 	int rc;
 	unsigned long long ts_value;
+#if ENABLE_SMC_STATS
+	pmf_smc_stats_t stats;
+#endif
 
 	/* Determine if the cpu exists of not */
 	if (!is_valid_mpidr(x2))
@@ -60,6 +70,41 @@ uintptr_t pmf_smc_handler(unsigned int smc_fid,
 					(unsigned int)x3, &ts_value);
 			SMC_RET2(handle, rc, ts_value);
 		}
+
+#if ENABLE_SMC_STATS
+		if (smc_fid == PMF_SMC_GET_SMC_STATS_64) {
+			/*
+			 * Return error code and the statistics of an SMC
+			 * function ID on a CPU.
+			 * x1 --> entry index, x2 --> mpidr.
+			 * x0 --> error code.
+			 * x1 --> SMC function ID.
+			 * x2 --> number of calls.
+			 * x3 --> ticks spent handling the calls.
+			 * x4 - x17 --> histogram, two buckets per register.
+			 */
+			rc = pmf_smc_stats_get(x2, x1, &stats);
+			if (rc != PSCI_E_SUCCESS) {
+				SMC_RET1(handle, rc);
+			}
+
+			SMC_RET18(handle, rc, stats.smc_fid, stats.count,
+				  stats.ticks, SMC_STATS_HIST(stats, 0),
+				  SMC_STATS_HIST(stats, 2),
+				  SMC_STATS_HIST(stats, 4),
+				  SMC_STATS_HIST(stats, 6),
+				  SMC_STATS_HIST(stats, 8),
+				  SMC_STATS_HIST(stats, 10),
+				  SMC_STATS_HIST(stats, 12),
+				  SMC_STATS_HIST(stats, 14),
+				  SMC_STATS_HIST(stats, 16),
+				  SMC_STATS_HIST(stats, 18),
+				  SMC_STATS_HIST(stats, 20),
+				  SMC_STATS_HIST(stats, 22),
+				  SMC_STATS_HIST(stats, 24),
+				  SMC_STATS_HIST(stats, 26));
+		}
+#endif /* ENABLE_SMC_STATS */
 	}
 
 	WARN("Unimplemented PMF Call: 0x%x \n", smc_fid);
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <arch_helpers.h>
+#include <common/runtime_svc.h>
+#include <lib/pmf/pmf.h>
+#include <lib/psci/psci.h>
+#include <lib/utils_def.h>
+#include <plat/common/platform.h>
+
+#include <platform_def.h>
+
+#ifndef PLAT_SMC_STATS_ENTRIES
+#define PLAT_SMC_STATS_ENTRIES		U(32)
+#endif
+
+CASSERT(IS_POWER_OF_TWO(PLAT_SMC_STATS_ENTRIES),
+	assert_plat_smc_stats_entries_power_of_two);
+
+/*
+ * Statistics of the SMCs handled by a CPU, in a table indexed by a hash of the
+ * function ID. Only the CPU itself updates it, so no lock is needed. Other CPUs
+ * may read an entry while it is being updated.
+ */
+typedef struct smc_stats_cpu {
+	pmf_smc_stats_t entries[PLAT_SMC_STATS_ENTRIES];
+	/* SMCs not counted because their function ID did not fit the table */
+	uint64_t dropped;
+} __aligned(CACHE_WRITEBACK_GRANULE) smc_stats_cpu_t;
+
+static smc_stats_cpu_t smc_stats[PLATFORM_CORE_COUNT];
+
+static unsigned int smc_stats_hash(uint32_t smc_fid)
+{
+	/* Mix the OEN and call type into the function number */
+	return (smc_fid ^ (smc_fid >> FUNCID_OEN_SHIFT)) &
+	       (PLAT_SMC_STATS_ENTRIES - 1U);
+}
+
+/*******************************************************************************
+ * Account an SMC handled by this CPU, whose handler was called when the system
+ * counter read 'start'. Called by the SMC dispatcher on return from the handler.
+ ******************************************************************************/
+void pmf_smc_stats_record(uint32_t smc_fid, uint64_t start)
+{
+	smc_stats_cpu_t *cpu = &smc_stats[plat_my_core_pos()];
+	uint64_t ticks = read_cntpct_el0() - start;
+	pmf_smc_stats_t *entry;
+	unsigned int i, n, bucket;
+
+	i = smc_stats_hash(smc_fid);
+	for (n = 0U; n < PLAT_SMC_STATS_ENTRIES; n++) {
+		entry = &cpu->entries[i];
+		if (entry->count == 0U) {
+			entry->smc_fid = smc_fid;
+			break;
+		}
+
+		if (entry->smc_fid == smc_fid) {
+			break;
+		}
+
+		i = (i + 1U) & (PLAT_SMC_STATS_ENTRIES - 1U);
+	}
+
+	if (n == PLAT_SMC_STATS_ENTRIES) {
+		cpu->dropped++;
+		return;
+	}
+
+	/* Bucket 'b' counts the calls that took [2^b, 2^(b+1)) ticks */
+	bucket = (ticks == 0U) ? 0U : (63U - (unsigned int)__builtin_clzll(ticks));
+	if (bucket >= PMF_SMC_STATS_HIST_BUCKETS) {
+		bucket = PMF_SMC_STATS_HIST_BUCKETS - 1U;
+	}
+
+	entry->hist[bucket]++;
+	entry->ticks += ticks;
+	entry->count++;
+}
+
+/*******************************************************************************
+ * Copy entry 'index' of the SMC statistics of the CPU 'mpidr' to 'stats'. The
+ * entry after the last one holds the number of SMCs that were not counted,
+ * with a function ID of SMC_UNK. Unused entries have a count of zero.
+ ******************************************************************************/
+int pmf_smc_stats_get(u_register_t mpidr, u_register_t index,
+		      pmf_smc_stats_t *stats)
+{
+	int pos = plat_core_pos_by_mpidr(mpidr);
+
+	if ((pos < 0) || ((unsigned int)pos >= PLATFORM_CORE_COUNT) ||
+	    (index > PLAT_SMC_STATS_ENTRIES)) {
+		return PSCI_E_INVALID_PARAMS;
+	}
+
+	if (index == PLAT_SMC_STATS_ENTRIES) {
+		(void)memset(stats, 0, sizeof(*stats));
+		stats->smc_fid = SMC_UNK;
+		stats->count = smc_stats[pos].dropped;
+	} else {
+		*stats = smc_stats[pos].entries[index];
+	}
+
+	return PSCI_E_SUCCESS;
+}
@@ -1164,6 +1164,11 @@ int psci_secondaries_brought_up(void)
  ******************************************************************************/
 void psci_pwrdown_cpu(unsigned int power_level)
 {
+#if CTX_LAZY_FPREGS
+	/* Save the FP/SIMD registers of whichever world still owns them */
+	cm_fpregs_context_flush();
+#endif
+
 #if HW_ASSISTED_COHERENCY
 	/*
 	 * With hardware-assisted coherency, the CPU drivers only initiate the
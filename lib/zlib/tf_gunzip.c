@@ -1,11 +1,12 @@
 /*
- * Copyright (c) 2018-2021, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
 #include <errno.h>
+#include <stdbool.h>
 #include <string.h>
 
 #include <common/debug.h>
@@ -24,6 +25,10 @@ static uintptr_t zalloc_start;
 static uintptr_t zalloc_end;
 static uintptr_t zalloc_current;
 
+/* State of the decompression done by gunzip_stream */
+static z_stream gunzip_strm;
+static bool gunzip_strm_done;
+
 static void * ZLIB_INTERNAL zcalloc(void *opaque, unsigned int items,
 				    unsigned int size)
 {
@@ -102,6 +107,104 @@ int gunzip(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
 	return ret;
 }
 
+/*
+ * gunzip_stream_init - start decompressing gzip data fed in pieces
+ * @out_buf: destination of decompressed output
+ * @out_len: length of out_buf
+ * @work_buf: workspace
+ * @work_len: length of workspace
+ */
+static int gunzip_stream_init(uintptr_t out_buf, size_t out_len,
+			      uintptr_t work_buf, size_t work_len)
+{
+	int zret;
+
+	zalloc_start = work_buf;
+	zalloc_end = work_buf + work_len;
+	zalloc_current = zalloc_start;
+
+	(void)memset(&gunzip_strm, 0, sizeof(gunzip_strm));
+	gunzip_strm.next_out = (typeof(gunzip_strm.next_out))out_buf;
+	gunzip_strm.avail_out = out_len;
+	gunzip_strm.zalloc = zcalloc;
+	gunzip_strm.zfree = zfree;
+	gunzip_strm.opaque = (voidpf)0;
+	gunzip_strm_done = false;
+
+	zret = inflateInit(&gunzip_strm);
+	if (zret != Z_OK) {
+		ERROR("zlib: inflate init failed (ret = %d)\n", zret);
+		return (zret == Z_MEM_ERROR) ? -ENOMEM : -EIO;
+	}
+
+	return 0;
+}
+
+/*
+ * gunzip_stream_feed - decompress the next piece of gzip data
+ * @in_buf: compressed input
+ * @in_len: length of in_buf
+ *
+ * Any data following the end of the gzip stream is ignored.
+ */
+static int gunzip_stream_feed(uintptr_t in_buf, size_t in_len)
+{
+	int zret;
+
+	if (gunzip_strm_done) {
+		return 0;
+	}
+
+	gunzip_strm.next_in = (typeof(gunzip_strm.next_in))in_buf;
+	gunzip_strm.avail_in = in_len;
+
+	zret = inflate(&gunzip_strm, Z_NO_FLUSH);
+	if (zret == Z_STREAM_END) {
+		gunzip_strm_done = true;
+		return 0;
+	}
+
+	/* All the input must be consumed unless the output is full */
+	if ((zret == Z_OK) && (gunzip_strm.avail_in == 0U)) {
+		return 0;
+	}
+
+	if (gunzip_strm.msg)
+		ERROR("%s\n", gunzip_strm.msg);
+	ERROR("zlib: inflate failed (ret = %d)\n", zret);
+
+	return (zret == Z_MEM_ERROR) ? -ENOMEM : -EIO;
+}
+
+/*
+ * gunzip_stream_end - complete decompressing gzip data
+ * @out_buf: upon exit, the end of output
+ */
+static int gunzip_stream_end(uintptr_t *out_buf)
+{
+	int ret = 0;
+
+	if (!gunzip_strm_done) {
+		ERROR("zlib: truncated input\n");
+		ret = -EIO;
+	}
+
+	VERBOSE("zlib: %lu byte input\n", gunzip_strm.total_in);
+	VERBOSE("zlib: %lu byte output\n", gunzip_strm.total_out);
+
+	*out_buf = (uintptr_t)gunzip_strm.next_out;
+
+	inflateEnd(&gunzip_strm);
+
+	return ret;
+}
+
+const decompressor_stream_t gunzip_stream = {
+	.init = gunzip_stream_init,
+	.feed = gunzip_stream_feed,
+	.end = gunzip_stream_end,
+};
+
 /* Wrapper function to calculate CRC
  * @crc: previous accumulated CRC
  * @buf: buffer base address
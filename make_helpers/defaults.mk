@@ -42,6 +42,10 @@ BL2_IN_XIP_MEM			:= 0
 # Do dcache invalidate upon BL2 entry at EL3
 BL2_INV_DCACHE			:= 1
 
+# Release the secondary CPUs during BL2 to hash and decompress images while the
+# primary CPU reads them
+BL2_WORKERS			:= 0
+
 # Select the branch protection features to use.
 BRANCH_PROTECTION		:= 0
 
@@ -63,6 +67,10 @@ CTX_INCLUDE_AARCH32_REGS	:= 1
 # Include FP registers in cpu context
 CTX_INCLUDE_FPREGS		:= 0
 
+# Switch the FP registers included in cpu context on first use rather than on
+# every world switch
+CTX_LAZY_FPREGS			:= 0
+
 # Debug build
 DEBUG				:= 0
 
@@ -91,12 +99,18 @@ ENABLE_PIE			:= 0
 # Flag to enable Performance Measurement Framework
 ENABLE_PMF			:= 0
 
+# Flag to record how long BL1 and BL2 spend in each phase of loading images
+ENABLE_BOOT_TIMELINE		:= 0
+
 # Flag to enable PSCI STATs functionality
 ENABLE_PSCI_STAT		:= 0
 
 # Flag to enable runtime instrumentation using PMF
 ENABLE_RUNTIME_INSTRUMENTATION	:= 0
 
+# Flag to count the SMCs handled by BL31 and time their handlers
+ENABLE_SMC_STATS		:= 0
+
 # Flag to enable stack corruption protection
 ENABLE_STACK_PROTECTOR		:= 0
 
@@ -130,6 +144,11 @@ FIP_ALIGN			:= 0
 # Default FIP file name
 FIP_NAME			:= fip.bin
 
+# Number of ToC entries the FIP driver caches per FIP device. 0 disables the
+# cache, so that opening a file always walks the ToC on the backend. Platforms
+# opt in by setting it in their platform.mk.
+FIP_TOC_INDEX_ENTRIES		:= 0
+
 # Default FWU_FIP file name
 FWU_FIP_NAME			:= fwu_fip.bin
 
@@ -173,6 +192,9 @@ ifeq ($(KEY_ALG),rsa)
 KEY_SIZE			:= 2048
 endif
 
+# Use the AArch64 assembly versions of memcpy, memmove, memcmp and strlen
+LIBC_ASM_STRING			:= 0
+
 # Option to build TF with Measured Boot support
 MEASURED_BOOT			:= 0
 
@@ -304,6 +326,11 @@ SANITIZE_UB := off
 # Default: disabled
 USE_SPINLOCK_CAS := 0
 
+# Number of locks protecting the GPT L1 tables. Granule transitions in L0
+# regions guarded by different locks can run in parallel. Must be a power of
+# two no greater than 64. Default: a single lock.
+RME_GPT_LOCK_COUNT		:= 1
+
 # Enable Link Time Optimization
 ENABLE_LTO			:= 0
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2023, Arm Limited. All rights reserved.
+ * Copyright (c) 2021-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -46,6 +46,11 @@ int plat_mboot_measure_image(unsigned int image_id, image_info_t *image_data)
 	return rc;
 }
 
+bool plat_mboot_is_event_log_image(unsigned int image_id)
+{
+	return event_log_has_data(image_id, fvp_event_log_metadata);
+}
+
 int plat_mboot_measure_key(const void *pk_oid, const void *pk_ptr,
 			   size_t pk_len)
 {
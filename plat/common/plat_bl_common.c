@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2018-2026, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -29,6 +29,15 @@
 #pragma weak plat_is_smccc_feature_available
 #pragma weak plat_get_soc_version
 #pragma weak plat_get_soc_revision
+#if BL2_WORKERS
+#pragma weak bl2_plat_workers_start
+#pragma weak bl2_plat_worker_exit
+#pragma weak bl2_plat_worker_has_exited
+#pragma weak bl2_plat_worker_revoke
+#endif
+#if MEASURED_BOOT
+#pragma weak plat_mboot_is_event_log_image
+#endif
 
 int32_t plat_get_soc_version(void)
 {
@@ -74,6 +83,41 @@ int plat_try_next_boot_source(void)
 	return 0;
 }
 
+#if BL2_WORKERS
+/* By default no secondary CPU is available to BL2 */
+unsigned int bl2_plat_workers_start(uintptr_t entrypoint __unused)
+{
+	return 0U;
+}
+
+void __dead2 bl2_plat_worker_exit(void)
+{
+	while (1)
+		wfe();
+}
+
+/* The default bl2_plat_worker_exit() never leaves BL2 memory */
+bool bl2_plat_worker_has_exited(unsigned int core_pos __unused)
+{
+	return false;
+}
+
+void bl2_plat_worker_revoke(unsigned int core_pos __unused)
+{
+}
+#endif /* BL2_WORKERS */
+
+#if MEASURED_BOOT
+/*
+ * By default the Event Log digest is not calculated while an image is loaded,
+ * and plat_mboot_measure_image() hashes the image again if it needs it.
+ */
+bool plat_mboot_is_event_log_image(unsigned int image_id __unused)
+{
+	return false;
+}
+#endif /* MEASURED_BOOT */
+
 /*
  * Weak implementation to provide dummy decryption key only for test purposes,
  * platforms must override this API for any real world firmware encryption
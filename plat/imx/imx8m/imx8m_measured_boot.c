@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022-2023, Arm Limited. All rights reserved.
+ * Copyright (c) 2022-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2022, Linaro.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -40,6 +40,11 @@ int plat_mboot_measure_image(unsigned int image_id, image_info_t *image_data)
 	return 0;
 }
 
+bool plat_mboot_is_event_log_image(unsigned int image_id)
+{
+	return event_log_has_data(image_id, imx8m_event_log_metadata);
+}
+
 void bl2_plat_mboot_init(void)
 {
 	event_log_init(event_log, event_log + sizeof(event_log));
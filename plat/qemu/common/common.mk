@@ -67,6 +67,11 @@ BL2_SOURCES		+=	drivers/io/io_semihosting.c		\
 				common/desc_image_load.c		\
 				common/fdt_fixup.c
 
+ifeq (${BL2_WORKERS},1)
+BL2_SOURCES		+=	${PLAT_QEMU_COMMON_PATH}/qemu_bl2_workers.c		\
+				${PLAT_QEMU_COMMON_PATH}/${ARCH}/qemu_bl2_workers.S
+endif
+
 BL31_SOURCES		+=	${QEMU_CPU_LIBS}				\
 				lib/semihosting/semihosting.c			\
 				lib/semihosting/${ARCH}/semihosting_call.S	\
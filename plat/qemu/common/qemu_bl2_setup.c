@@ -17,6 +17,7 @@
 #include <common/desc_image_load.h>
 #include <common/fdt_fixup.h>
 #include <common/fdt_wrappers.h>
+#include <lib/boot_timeline.h>
 #include <lib/optee_utils.h>
 #if TRANSFER_LIST
 #include <lib/transfer_list.h>
@@ -328,6 +329,9 @@ static int qemu_bl2_handle_post_image_load(unsigned int image_id)
 		bl_mem_params->ep_info.args.arg3 = 0U;
 #elif TRANSFER_LIST
 		if (bl2_tl) {
+			/* BL33 is the last image: publish how loading went */
+			(void)boot_timeline_publish(bl2_tl);
+
 			// relocate the tl to pre-allocate NS memory
 			ns_tl = transfer_list_relocate(bl2_tl,
 					(void *)(uintptr_t)FW_NS_HANDOFF_BASE,
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include <libfdt.h>
+
+#include <platform_def.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <common/fdt_wrappers.h>
+#include <plat/common/platform.h>
+
+#include "qemu_private.h"
+
+/* Where qemu_bl2_worker_el3_entry() sends the workers, read with the MMU off */
+uintptr_t qemu_bl2_worker_ep;
+
+/*******************************************************************************
+ * Release the secondary CPUs described in the DT from the BL1 holding pen. They
+ * go back there through bl2_plat_worker_exit(), so BL31 can bring them up with
+ * PSCI as usual.
+ ******************************************************************************/
+unsigned int bl2_plat_workers_start(uintptr_t entrypoint)
+{
+	void *fdt = (void *)(uintptr_t)ARM_PRELOADED_DTB_BASE;
+	uintptr_t *mailbox = (void *)PLAT_QEMU_TRUSTED_MAILBOX_BASE;
+	uint64_t *hold_base = (uint64_t *)PLAT_QEMU_HOLD_BASE;
+	u_register_t my_mpidr = read_mpidr() & MPIDR_AFFINITY_MASK;
+	const char *type;
+	uintptr_t mpidr;
+	unsigned int pos, count = 0U;
+	int cpus, node;
+
+	cpus = fdt_path_offset(fdt, "/cpus");
+	if (cpus < 0) {
+		WARN("BL2: no /cpus node in DT, not using workers\n");
+		return 0U;
+	}
+
+	qemu_bl2_worker_ep = entrypoint;
+	flush_dcache_range((uintptr_t)&qemu_bl2_worker_ep,
+			   sizeof(qemu_bl2_worker_ep));
+
+	*mailbox = (uintptr_t)qemu_bl2_worker_el3_entry;
+	dsbish();
+
+	/* Only release the CPUs QEMU was started with */
+	fdt_for_each_subnode(node, fdt, cpus) {
+		type = fdt_getprop(fdt, node, "device_type", NULL);
+		if ((type == NULL) || (strcmp(type, "cpu") != 0)) {
+			continue;
+		}
+
+		if ((fdt_get_reg_props_by_index(fdt, node, 0, &mpidr,
+						NULL) != 0) ||
+		    ((mpidr & MPIDR_AFFINITY_MASK) == my_mpidr)) {
+			continue;
+		}
+
+		pos = plat_qemu_calc_core_pos(mpidr);
+		if (pos >= PLATFORM_CORE_COUNT) {
+			continue;
+		}
+
+		hold_base[pos] = PLAT_QEMU_HOLD_STATE_GO;
+		count++;
+	}
+
+	dsbish();
+	sev();
+
+	return count;
+}
+
+/*******************************************************************************
+ * A worker has exited once it is back in the holding pen, which runs from BL1
+ * ROM.
+ ******************************************************************************/
+bool bl2_plat_worker_has_exited(unsigned int core_pos)
+{
+	volatile uint8_t *parked = (uint8_t *)PLAT_QEMU_PARKED_BASE;
+
+	return parked[core_pos] != 0U;
+}
+
+/*******************************************************************************
+ * Keep a CPU released by bl2_plat_workers_start() in the holding pen, so that
+ * it does not leave it once BL31 has set its own entrypoint in the mailbox. A
+ * CPU let go already but yet to read the mailbox goes back through the BL1
+ * reset path to the holding pen.
+ ******************************************************************************/
+void bl2_plat_worker_revoke(unsigned int core_pos)
+{
+	uintptr_t *mailbox = (void *)PLAT_QEMU_TRUSTED_MAILBOX_BASE;
+	uint64_t *hold_base = (uint64_t *)PLAT_QEMU_HOLD_BASE;
+
+	*mailbox = BL1_RO_BASE;
+	hold_base[core_pos] = PLAT_QEMU_HOLD_STATE_WAIT;
+	dsbish();
+}
@@ -42,4 +42,6 @@ int qemu_set_nt_fw_info(
 
 void qemu_bl2_sync_transfer_list(void);
 
+void qemu_bl2_worker_el3_entry(void);
+
 #endif /* QEMU_PRIVATE_H */
@@ -105,7 +105,8 @@
 #define SHARED_RAM_SIZE			0x00001000
 
 #define PLAT_QEMU_TRUSTED_MAILBOX_BASE	SHARED_RAM_BASE
-#define PLAT_QEMU_TRUSTED_MAILBOX_SIZE	(8 + PLAT_QEMU_HOLD_SIZE)
+#define PLAT_QEMU_TRUSTED_MAILBOX_SIZE	(8 + PLAT_QEMU_HOLD_SIZE + \
+					 PLAT_QEMU_PARKED_SIZE)
 #define PLAT_QEMU_HOLD_BASE		(PLAT_QEMU_TRUSTED_MAILBOX_BASE + 8)
 #define PLAT_QEMU_HOLD_SIZE		(PLATFORM_CORE_COUNT * \
 					 PLAT_QEMU_HOLD_ENTRY_SIZE)
@@ -113,6 +114,16 @@
 #define PLAT_QEMU_HOLD_ENTRY_SIZE	(1 << PLAT_QEMU_HOLD_ENTRY_SHIFT)
 #define PLAT_QEMU_HOLD_STATE_WAIT	0
 #define PLAT_QEMU_HOLD_STATE_GO		1
+/* Set by the holding pen while a CPU waits in it, one byte per CPU */
+#define PLAT_QEMU_PARKED_BASE		(PLAT_QEMU_HOLD_BASE + \
+					 PLAT_QEMU_HOLD_SIZE)
+#define PLAT_QEMU_PARKED_SIZE		PLATFORM_CORE_COUNT
+
+/* The rest of the shared RAM holds the boot timeline from BL1 to BL2 */
+#define PLAT_BOOT_TIMELINE_BASE		(PLAT_QEMU_TRUSTED_MAILBOX_BASE + \
+					 PLAT_QEMU_TRUSTED_MAILBOX_SIZE)
+#define PLAT_BOOT_TIMELINE_SIZE		(SHARED_RAM_SIZE - \
+					 PLAT_QEMU_TRUSTED_MAILBOX_SIZE)
 
 #define BL_RAM_BASE			(SHARED_RAM_BASE + SHARED_RAM_SIZE)
 #define BL_RAM_SIZE			(SEC_SRAM_SIZE - SHARED_RAM_SIZE)
@@ -9,6 +9,7 @@ PLAT_QEMU_COMMON_PATH	:=      plat/qemu/common
 
 SEPARATE_CODE_AND_RODATA := 1
 ENABLE_STACK_PROTECTOR	 := 0
+FIP_TOC_INDEX_ENTRIES	 := 16
 
 include plat/qemu/common/common.mk
 
@@ -162,6 +163,13 @@ ifeq (${SDEI_SUPPORT}, 1)
 BL31_SOURCES		+=	plat/qemu/common/qemu_sdei.c
 endif
 
+# The SiP service only dispatches the PMF calls, e.g. to read the statistics
+# kept with ENABLE_SMC_STATS
+ifeq (${ENABLE_PMF}, 1)
+BL31_SOURCES		+=	lib/pmf/pmf_smc.c			\
+				${PLAT_QEMU_COMMON_PATH}/qemu_sip_svc.c
+endif
+
 ifeq (${SPD},spmd)
 BL31_SOURCES		+=	plat/common/plat_spmd_manifest.c	\
 				common/uuid.c				\
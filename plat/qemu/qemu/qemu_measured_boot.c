@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022, Arm Limited. All rights reserved.
+ * Copyright (c) 2022-2026, Arm Limited. All rights reserved.
  * Copyright (c) 2022-2023, Linaro.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -119,6 +119,11 @@ int plat_mboot_measure_image(unsigned int image_id, image_info_t *image_data)
 	return 0;
 }
 
+bool plat_mboot_is_event_log_image(unsigned int image_id)
+{
+	return event_log_has_data(image_id, qemu_event_log_metadata);
+}
+
 int plat_mboot_measure_key(const void *pk_oid, const void *pk_ptr,
 			   size_t pk_len)
 {
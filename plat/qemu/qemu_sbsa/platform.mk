@@ -44,6 +44,11 @@ BL31_SOURCES		+=	${PLAT_QEMU_PATH}/sbsa_gic.c 			\
 
 BL31_SOURCES		+=	${FDT_WRAPPERS_SOURCES}
 
+# The SiP service also dispatches the PMF calls
+ifeq (${ENABLE_PMF}, 1)
+BL31_SOURCES		+=	lib/pmf/pmf_smc.c
+endif
+
 ifeq (${SPM_MM},1)
 	BL31_SOURCES		+=	${PLAT_QEMU_COMMON_PATH}/qemu_spm.c
 endif
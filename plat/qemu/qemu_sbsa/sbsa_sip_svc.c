@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2023, Linaro Limited and Contributors. All rights reserved.
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -8,6 +9,7 @@
 
 #include <common/fdt_wrappers.h>
 #include <common/runtime_svc.h>
+#include <lib/pmf/pmf.h>
 #include <libfdt.h>
 #include <smccc_helpers.h>
 
@@ -145,6 +147,17 @@ uintptr_t sbsa_sip_smc_handler(uint32_t smc_fid,
 {
 	uint32_t ns;
 
+#if ENABLE_PMF
+	/*
+	 * Dispatch PMF calls to PMF SMC handler and return its return
+	 * value
+	 */
+	if (is_pmf_fid(smc_fid)) {
+		return pmf_smc_handler(smc_fid, x1, x2, x3, x4, cookie,
+				       handle, flags);
+	}
+#endif /* ENABLE_PMF */
+
 	/* Determine which security state this SMC originated from */
 	ns = is_caller_non_secure(flags);
 	if (!ns) {
@@ -172,7 +185,11 @@ uintptr_t sbsa_sip_smc_handler(uint32_t smc_fid,
 
 int sbsa_sip_smc_setup(void)
 {
+#if ENABLE_PMF
+	return pmf_setup();
+#else
 	return 0;
+#endif
 }
 
 /* Define a runtime service descriptor for fast SMC calls */
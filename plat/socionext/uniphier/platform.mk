@@ -1,5 +1,5 @@
 #
-# Copyright (c) 2017-2023, ARM Limited and Contributors. All rights reserved.
+# Copyright (c) 2017-2026, ARM Limited and Contributors. All rights reserved.
 #
 # SPDX-License-Identifier: BSD-3-Clause
 #
@@ -125,6 +125,18 @@ BL2_SOURCES		+=	common/image_decompress.c		\
 
 $(eval $(call add_define,UNIPHIER_DECOMPRESS_GZIP))
 
+# Decompress the images while they are read from the FIP, instead of reading
+# each of them whole into the image buffer first
+UNIPHIER_GZIP_STREAM	?= 0
+$(eval $(call assert_boolean,UNIPHIER_GZIP_STREAM))
+$(eval $(call add_define,UNIPHIER_GZIP_STREAM))
+
+ifeq (${UNIPHIER_GZIP_STREAM},1)
+ifeq (${TRUSTED_BOARD_BOOT},1)
+$(error "UNIPHIER_GZIP_STREAM cannot be used with TRUSTED_BOARD_BOOT")
+endif
+endif
+
 # compress all images loaded by BL2
 SCP_BL2_PRE_TOOL_FILTER	:= GZIP
 BL31_PRE_TOOL_FILTER	:= GZIP
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2026, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -23,6 +23,13 @@
 
 #define UNIPHIER_IMAGE_BUF_OFFSET	0x03800000UL
 #define UNIPHIER_IMAGE_BUF_SIZE		0x00800000UL
+/*
+ * When streaming, only the start of the image buffer is used: a chunk the
+ * compressed data is read into, followed by the workspace of zlib (about 7KB
+ * of inflate state and a 32KB window).
+ */
+#define UNIPHIER_IMAGE_CHUNK_SIZE	0x00010000UL
+#define UNIPHIER_IMAGE_WORK_SIZE	0x00010000UL
 
 static uintptr_t uniphier_mem_base = UNIPHIER_MEM_BASE;
 static unsigned int uniphier_soc = UNIPHIER_SOC_UNKNOWN;
@@ -112,15 +119,26 @@ void bl2_plat_preload_setup(void)
 {
 #ifdef UNIPHIER_DECOMPRESS_GZIP
 	uintptr_t buf_base = uniphier_mem_base + UNIPHIER_IMAGE_BUF_OFFSET;
+#if UNIPHIER_GZIP_STREAM
+	size_t buf_size = UNIPHIER_IMAGE_CHUNK_SIZE + UNIPHIER_IMAGE_WORK_SIZE;
+#else
+	size_t buf_size = UNIPHIER_IMAGE_BUF_SIZE;
+#endif
 	int ret;
 
-	ret = mmap_add_dynamic_region(buf_base, buf_base,
-				      UNIPHIER_IMAGE_BUF_SIZE,
+	ret = mmap_add_dynamic_region(buf_base, buf_base, buf_size,
 				      MT_MEMORY | MT_RW | MT_NS);
 	if (ret)
 		plat_error_handler(ret);
 
+#if UNIPHIER_GZIP_STREAM
+	image_decompress_init_stream(buf_base, UNIPHIER_IMAGE_CHUNK_SIZE,
+				     buf_base + UNIPHIER_IMAGE_CHUNK_SIZE,
+				     UNIPHIER_IMAGE_WORK_SIZE,
+				     &gunzip_stream);
+#else
 	image_decompress_init(buf_base, UNIPHIER_IMAGE_BUF_SIZE, gunzip);
+#endif
 #endif
 
 	uniphier_init_image_descs(uniphier_mem_base);
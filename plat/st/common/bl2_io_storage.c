@@ -69,6 +69,12 @@ static io_block_dev_spec_t mmc_block_dev_spec = {
 		.write = NULL,
 	},
 	.block_size = MMC_BLOCK_SIZE,
+	/*
+	 * SDMMC2 reads whole words, and its IDMA invalidates the destination:
+	 * keep it from sharing a cache line with data already read.
+	 */
+	.direct_read_align = CACHE_WRITEBACK_GRANULE,
+	.max_direct_read = SDMMC2_MAX_READ_SIZE,
 };
 
 static const io_dev_connector_t *mmc_dev_con;
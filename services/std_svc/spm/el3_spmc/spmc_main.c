@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2022-2026, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -39,6 +39,28 @@
  */
 static struct secure_partition_desc sp_desc[SECURE_PARTITION_COUNT];
 
+/*
+ * Map from the ID of each SP to its descriptor, for spmc_get_sp_ctx(). It is a
+ * hash table with open addressing holding the index of the descriptor in
+ * sp_desc[] plus one, zero marking a free entry. Being twice as large as
+ * sp_desc[] keeps it at most half full, so probing always ends.
+ */
+#define SP_ID_MAP_SIZE		(2U * SECURE_PARTITION_COUNT)
+
+CASSERT(SECURE_PARTITION_COUNT < UINT8_MAX, assert_sp_id_map_index_size);
+
+static uint8_t sp_id_map[SP_ID_MAP_SIZE];
+
+/*
+ * FFA_PARTITION_INFO_GET descriptors of all the partitions, as returned for the
+ * null UUID to FF-A v1.1 and v1.0 callers. What they describe does not change
+ * once spmc_setup() has parsed the partition manifests, so they are built
+ * there and copied as is into the RX buffer of the callers.
+ */
+static struct ffa_partition_info_v1_1 partition_info_v1_1[MAX_SP_LP_PARTITIONS];
+static struct ffa_partition_info_v1_0 partition_info_v1_0[MAX_SP_LP_PARTITIONS];
+static uint32_t partition_info_count;
+
 /*
  * Allocate an NS endpoint descriptor to describe each VM and the Hypervisor in
  * the system that interacts with a SP. It is used to track the Hypervisor
@@ -83,15 +105,34 @@ struct sp_exec_ctx *spmc_get_sp_ec(struct secure_partition_desc *sp)
 /* Helper function to get pointer to SP context from its ID. */
 struct secure_partition_desc *spmc_get_sp_ctx(uint16_t id)
 {
+	unsigned int slot = id % SP_ID_MAP_SIZE;
+	unsigned int index;
+
 	/* Check for Secure World Partitions. */
-	for (unsigned int i = 0U; i < SECURE_PARTITION_COUNT; i++) {
-		if (sp_desc[i].sp_id == id) {
-			return &(sp_desc[i]);
+	while (sp_id_map[slot] != 0U) {
+		index = sp_id_map[slot] - 1U;
+		if (sp_desc[index].sp_id == id) {
+			return &(sp_desc[index]);
 		}
+		slot = (slot + 1U) % SP_ID_MAP_SIZE;
 	}
 	return NULL;
 }
 
+/* Helper function to make an SP context found by spmc_get_sp_ctx(). */
+static void spmc_add_sp_ctx(struct secure_partition_desc *sp)
+{
+	unsigned int slot = sp->sp_id % SP_ID_MAP_SIZE;
+
+	assert(sp->sp_id != INV_SP_ID);
+	assert(spmc_get_sp_ctx(sp->sp_id) == NULL);
+
+	while (sp_id_map[slot] != 0U) {
+		slot = (slot + 1U) % SP_ID_MAP_SIZE;
+	}
+	sp_id_map[slot] = (uint8_t)(sp - sp_desc) + 1U;
+}
+
 /*
  * Helper function to obtain the descriptor of the Hypervisor or OS kernel.
  * We assume that the first descriptor is reserved for this entity.
@@ -852,135 +893,125 @@ partition_info_get_populate_properties(uint32_t sp_properties,
 }
 
 /*
- * Collate the partition information in a v1.1 partition information
- * descriptor format, this will be converter later if required.
+ * Build the partition information descriptors of all the partitions, in the
+ * v1.1 format and converted to the v1.0 one.
  */
-static int partition_info_get_handler_v1_1(uint32_t *uuid,
-					   struct ffa_partition_info_v1_1
-						  *partitions,
-					   uint32_t max_partitions,
-					   uint32_t *partition_count)
+static void partition_info_init(void)
 {
 	uint32_t index;
 	struct ffa_partition_info_v1_1 *desc;
-	bool null_uuid = is_null_uuid(uuid);
 	struct el3_lp_desc *el3_lp_descs = get_el3_lp_array();
 
+	assert(EL3_LP_DESCS_COUNT <= MAX_EL3_LP_DESCS_COUNT);
+
 	/* Deal with Logical Partitions. */
 	for (index = 0U; index < EL3_LP_DESCS_COUNT; index++) {
-		if (null_uuid || uuid_match(uuid, el3_lp_descs[index].uuid)) {
-			/* Found a matching UUID, populate appropriately. */
-			if (*partition_count >= max_partitions) {
-				return FFA_ERROR_NO_MEMORY;
-			}
-
-			desc = &partitions[*partition_count];
-			desc->ep_id = el3_lp_descs[index].sp_id;
-			desc->execution_ctx_count = PLATFORM_CORE_COUNT;
-			/* LSPs must be AArch64. */
-			desc->properties =
-				partition_info_get_populate_properties(
-					el3_lp_descs[index].properties,
-					SP_STATE_AARCH64);
-
-			if (null_uuid) {
-				copy_uuid(desc->uuid, el3_lp_descs[index].uuid);
-			}
-			(*partition_count)++;
-		}
+		desc = &partition_info_v1_1[partition_info_count];
+		desc->ep_id = el3_lp_descs[index].sp_id;
+		desc->execution_ctx_count = PLATFORM_CORE_COUNT;
+		/* LSPs must be AArch64. */
+		desc->properties =
+			partition_info_get_populate_properties(
+				el3_lp_descs[index].properties,
+				SP_STATE_AARCH64);
+		copy_uuid(desc->uuid, el3_lp_descs[index].uuid);
+		partition_info_count++;
 	}
 
 	/* Deal with physical SP's. */
 	for (index = 0U; index < SECURE_PARTITION_COUNT; index++) {
-		if (null_uuid || uuid_match(uuid, sp_desc[index].uuid)) {
-			/* Found a matching UUID, populate appropriately. */
-			if (*partition_count >= max_partitions) {
-				return FFA_ERROR_NO_MEMORY;
-			}
-
-			desc = &partitions[*partition_count];
-			desc->ep_id = sp_desc[index].sp_id;
-			/*
-			 * Execution context count must match No. cores for
-			 * S-EL1 SPs.
-			 */
-			desc->execution_ctx_count = PLATFORM_CORE_COUNT;
-			desc->properties =
-				partition_info_get_populate_properties(
-					sp_desc[index].properties,
-					sp_desc[index].execution_state);
-
-			if (null_uuid) {
-				copy_uuid(desc->uuid, sp_desc[index].uuid);
-			}
-			(*partition_count)++;
+		/* Skip descriptors left unused. */
+		if (sp_desc[index].sp_id == INV_SP_ID) {
+			continue;
 		}
+
+		desc = &partition_info_v1_1[partition_info_count];
+		desc->ep_id = sp_desc[index].sp_id;
+		/*
+		 * Execution context count must match No. cores for
+		 * S-EL1 SPs.
+		 */
+		desc->execution_ctx_count = PLATFORM_CORE_COUNT;
+		desc->properties =
+			partition_info_get_populate_properties(
+				sp_desc[index].properties,
+				sp_desc[index].execution_state);
+		copy_uuid(desc->uuid, sp_desc[index].uuid);
+		partition_info_count++;
+	}
+
+	for (index = 0U; index < partition_info_count; index++) {
+		partition_info_v1_0[index].ep_id =
+			partition_info_v1_1[index].ep_id;
+		partition_info_v1_0[index].execution_ctx_count =
+			partition_info_v1_1[index].execution_ctx_count;
+		/* Only report v1.0 properties. */
+		partition_info_v1_0[index].properties =
+			(partition_info_v1_1[index].properties &
+			FFA_PARTITION_INFO_GET_PROPERTIES_V1_0_MASK);
 	}
-	return 0;
 }
 
 /*
- * Handle the case where that caller only wants the count of partitions
- * matching a given UUID and does not want the corresponding descriptors
- * populated.
+ * Count the partitions matching a given UUID, all of them for the null UUID.
  */
-static uint32_t partition_info_get_handler_count_only(uint32_t *uuid)
+static uint32_t partition_info_get_count(uint32_t *uuid)
 {
-	uint32_t index = 0;
+	uint32_t index;
 	uint32_t partition_count = 0;
-	bool null_uuid = is_null_uuid(uuid);
-	struct el3_lp_desc *el3_lp_descs = get_el3_lp_array();
 
-	/* Deal with Logical Partitions. */
-	for (index = 0U; index < EL3_LP_DESCS_COUNT; index++) {
-		if (null_uuid ||
-		    uuid_match(uuid, el3_lp_descs[index].uuid)) {
-			(partition_count)++;
-		}
+	if (is_null_uuid(uuid)) {
+		return partition_info_count;
 	}
 
-	/* Deal with physical SP's. */
-	for (index = 0U; index < SECURE_PARTITION_COUNT; index++) {
-		if (null_uuid || uuid_match(uuid, sp_desc[index].uuid)) {
-			(partition_count)++;
+	for (index = 0U; index < partition_info_count; index++) {
+		if (uuid_match(uuid, partition_info_v1_1[index].uuid)) {
+			partition_count++;
 		}
 	}
 	return partition_count;
 }
 
 /*
- * If the caller of the PARTITION_INFO_GET ABI was a v1.0 caller, populate
- * the corresponding descriptor format from the v1.1 descriptor array.
+ * Copy the descriptors of the partitions matching a given UUID to 'buf', in
+ * the format of the FF-A version of the caller. The UUID is only reported for
+ * the null UUID.
  */
-static uint64_t partition_info_populate_v1_0(struct ffa_partition_info_v1_1
-					     *partitions,
-					     struct mailbox *mbox,
-					     int partition_count)
+static void partition_info_get_copy(uint32_t *uuid, uint32_t ffa_version,
+				    void *buf)
 {
 	uint32_t index;
-	uint32_t buf_size;
-	uint32_t descriptor_size;
-	struct ffa_partition_info_v1_0 *v1_0_partitions =
-		(struct ffa_partition_info_v1_0 *) mbox->rx_buffer;
-
-	buf_size = mbox->rxtx_page_count * FFA_PAGE_SIZE;
-	descriptor_size = partition_count *
-			  sizeof(struct ffa_partition_info_v1_0);
-
-	if (descriptor_size > buf_size) {
-		return FFA_ERROR_NO_MEMORY;
+	struct ffa_partition_info_v1_0 *v1_0_partitions = buf;
+	struct ffa_partition_info_v1_1 *v1_1_partitions = buf;
+	bool v1_0 = (ffa_version == MAKE_FFA_VERSION(U(1), U(0)));
+
+	if (is_null_uuid(uuid)) {
+		if (v1_0) {
+			(void)memcpy(buf, partition_info_v1_0,
+				     partition_info_count *
+				     sizeof(struct ffa_partition_info_v1_0));
+		} else {
+			(void)memcpy(buf, partition_info_v1_1,
+				     partition_info_count *
+				     sizeof(struct ffa_partition_info_v1_1));
+		}
+		return;
 	}
 
-	for (index = 0U; index < partition_count; index++) {
-		v1_0_partitions[index].ep_id = partitions[index].ep_id;
-		v1_0_partitions[index].execution_ctx_count =
-			partitions[index].execution_ctx_count;
-		/* Only report v1.0 properties. */
-		v1_0_partitions[index].properties =
-			(partitions[index].properties &
-			FFA_PARTITION_INFO_GET_PROPERTIES_V1_0_MASK);
+	for (index = 0U; index < partition_info_count; index++) {
+		if (!uuid_match(uuid, partition_info_v1_1[index].uuid)) {
+			continue;
+		}
+
+		if (v1_0) {
+			*v1_0_partitions++ = partition_info_v1_0[index];
+		} else {
+			*v1_1_partitions = partition_info_v1_1[index];
+			zeromem(v1_1_partitions->uuid,
+				sizeof(v1_1_partitions->uuid));
+			v1_1_partitions++;
+		}
 	}
-	return 0;
 }
 
 /*
@@ -1005,6 +1036,8 @@ static uint64_t partition_info_get_handler(uint32_t smc_fid,
 	uint64_t info_get_flags;
 	bool count_only;
 	uint32_t uuid[4];
+	uint32_t buf_size;
+	uint32_t desc_size;
 
 	uuid[0] = x1;
 	uuid[1] = x2;
@@ -1015,38 +1048,21 @@ static uint64_t partition_info_get_handler(uint32_t smc_fid,
 	info_get_flags = SMC_GET_GP(handle, CTX_GPREG_X5);
 	count_only = (info_get_flags & FFA_PARTITION_INFO_GET_COUNT_FLAG_MASK);
 
-	/* Handle the case where we don't need to populate the descriptors. */
-	if (count_only) {
-		partition_count = partition_info_get_handler_count_only(uuid);
-		if (partition_count == 0) {
-			return spmc_ffa_error_return(handle,
-						FFA_ERROR_INVALID_PARAMETER);
-		}
-	} else {
-		struct ffa_partition_info_v1_1 partitions[MAX_SP_LP_PARTITIONS];
+	/* If we didn't find any matches the UUID is unknown. */
+	partition_count = partition_info_get_count(uuid);
+	if (partition_count == 0) {
+		return spmc_ffa_error_return(handle,
+					     FFA_ERROR_INVALID_PARAMETER);
+	}
 
+	/* Handle the case where we don't need to populate the descriptors. */
+	if (!count_only) {
 		/*
 		 * Handle the case where the partition descriptors are required,
 		 * check we have the buffers available and populate the
 		 * appropriate structure version.
 		 */
 
-		/* Obtain the v1.1 format of the descriptors. */
-		ret = partition_info_get_handler_v1_1(uuid, partitions,
-						      MAX_SP_LP_PARTITIONS,
-						      &partition_count);
-
-		/* Check if an error occurred during discovery. */
-		if (ret != 0) {
-			goto err;
-		}
-
-		/* If we didn't find any matches the UUID is unknown. */
-		if (partition_count == 0) {
-			ret = FFA_ERROR_INVALID_PARAMETER;
-			goto err;
-		}
-
 		/* Obtain the partition mailbox RX/TX buffer pair descriptor. */
 		mbox = spmc_get_mbox_desc(secure_origin);
 
@@ -1066,36 +1082,27 @@ static uint64_t partition_info_get_handler(uint32_t smc_fid,
 			goto err_unlock;
 		}
 
-		/* Zero the RX buffer before populating. */
-		(void)memset(mbox->rx_buffer, 0,
-			     mbox->rxtx_page_count * FFA_PAGE_SIZE);
-
 		/*
 		 * Depending on the FF-A version of the requesting partition
-		 * we may need to convert to a v1.0 format otherwise we can copy
-		 * directly.
+		 * the descriptors are in the v1.0 or v1.1 format. The size of
+		 * the descriptors is only reported from v1.1.
 		 */
 		if (ffa_version == MAKE_FFA_VERSION(U(1), U(0))) {
-			ret = partition_info_populate_v1_0(partitions,
-							   mbox,
-							   partition_count);
-			if (ret != 0) {
-				goto err_unlock;
-			}
+			desc_size = sizeof(struct ffa_partition_info_v1_0);
 		} else {
-			uint32_t buf_size = mbox->rxtx_page_count *
-					    FFA_PAGE_SIZE;
-
-			/* Ensure the descriptor will fit in the buffer. */
-			size = sizeof(struct ffa_partition_info_v1_1);
-			if (partition_count * size  > buf_size) {
-				ret = FFA_ERROR_NO_MEMORY;
-				goto err_unlock;
-			}
-			memcpy(mbox->rx_buffer, partitions,
-			       partition_count * size);
+			desc_size = sizeof(struct ffa_partition_info_v1_1);
+			size = desc_size;
+		}
+
+		/* Ensure the descriptors will fit in the buffer. */
+		buf_size = mbox->rxtx_page_count * FFA_PAGE_SIZE;
+		if (partition_count * desc_size > buf_size) {
+			ret = FFA_ERROR_NO_MEMORY;
+			goto err_unlock;
 		}
 
+		partition_info_get_copy(uuid, ffa_version, mbox->rx_buffer);
+
 		mbox->state = MAILBOX_STATE_FULL;
 		spin_unlock(&mbox->lock);
 	}
@@ -1103,7 +1110,6 @@ static uint64_t partition_info_get_handler(uint32_t smc_fid,
 
 err_unlock:
 	spin_unlock(&mbox->lock);
-err:
 	return spmc_ffa_error_return(handle, ret);
 }
 
@@ -1733,6 +1739,9 @@ static int find_and_prepare_sp_context(void)
 	/* Perform any common initialisation. */
 	spmc_sp_common_setup(sp, next_image_ep_info, boot_info_reg);
 
+	/* Make the SP found by its ID, now that it has its final one. */
+	spmc_add_sp_ctx(sp);
+
 	/* Perform any initialisation specific to S-EL1 SPs. */
 	spmc_el1_sp_setup(sp, next_image_ep_info);
 
@@ -1899,6 +1908,7 @@ int32_t spmc_setup(void)
 		return ret;
 	}
 	memset(spmc_shmem_obj_state.data, 0, spmc_shmem_obj_state.data_size);
+	spmc_shmem_obj_state_init(&spmc_shmem_obj_state);
 
 	/* Setup logical SPs. */
 	ret = logical_sp_init();
@@ -1921,6 +1931,9 @@ int32_t spmc_setup(void)
 		return ret;
 	}
 
+	/* Build the responses to FFA_PARTITION_INFO_GET. */
+	partition_info_init();
+
 	/* Register power management hooks with PSCI */
 	psci_register_spd_pm_hook(&spmc_pm);
 
@@ -20,6 +20,11 @@
 
 /**
  * struct spmc_shmem_obj - Shared memory object.
+ * @block_size:     Number of bytes of the datastore used by this object,
+ *                  including this header and any padding.
+ * @next:           Next object in the same handle hash bucket once published,
+ *                  or next free block in address order while free.
+ * @free:           True if this block is on the free list.
  * @desc_size:      Size of @desc.
  * @desc_filled:    Size of @desc already received.
  * @in_use:         Number of clients that have called ffa_mem_retrieve_req
@@ -27,12 +32,29 @@
  * @desc:           FF-A memory region descriptor passed in ffa_mem_share.
  */
 struct spmc_shmem_obj {
+	size_t block_size;
+	struct spmc_shmem_obj *next;
+	bool free;
 	size_t desc_size;
 	size_t desc_filled;
 	size_t in_use;
 	struct ffa_mtd desc;
 };
 
+/* Alignment of every block carved out of the datastore. */
+#define SPMC_SHMEM_BLOCK_ALIGN		16U
+
+/*
+ * Smallest block worth splitting off a free block. Blocks always have room
+ * for a whole struct spmc_shmem_obj, as the descriptor header is cleared on
+ * allocation even if the descriptor is smaller.
+ */
+#define SPMC_SHMEM_MIN_BLOCK_SIZE	\
+	round_up(sizeof(struct spmc_shmem_obj), SPMC_SHMEM_BLOCK_ALIGN)
+
+CASSERT((SPMC_SHMEM_OBJ_HASH_SIZE & (SPMC_SHMEM_OBJ_HASH_SIZE - 1)) == 0,
+	assert_spmc_shmem_obj_hash_size_not_power_of_2);
+
 /*
  * Declare our data structure to store the metadata of memory share requests.
  * The main datastore is allocated on a per platform basis to ensure enough
@@ -57,12 +79,62 @@ static size_t spmc_shmem_obj_size(size_t desc_size)
 	return desc_size + offsetof(struct spmc_shmem_obj, desc);
 }
 
+/**
+ * spmc_shmem_obj_hash - Get the hash bucket of a handle.
+ * @state:      Global state.
+ * @handle:     Handle of the object.
+ *
+ * Handles are allocated sequentially so their low bits spread objects evenly
+ * across buckets.
+ *
+ * Return: Pointer to the head of the bucket holding @handle.
+ */
+static struct spmc_shmem_obj **
+spmc_shmem_obj_hash(struct spmc_shmem_obj_state *state, uint64_t handle)
+{
+	return &state->hash[handle & (SPMC_SHMEM_OBJ_HASH_SIZE - 1U)];
+}
+
+/**
+ * spmc_shmem_obj_state_init - Initialise the datastore allocator.
+ * @state:      Global state, with @state->data and @state->data_size set.
+ *
+ * Turn the whole datastore into a single free block.
+ */
+void spmc_shmem_obj_state_init(struct spmc_shmem_obj_state *state)
+{
+	struct spmc_shmem_obj *blk;
+
+	memset(state->hash, 0, sizeof(state->hash));
+	state->free_list = NULL;
+	state->allocated = 0;
+	state->data_size = round_down(state->data_size,
+				      SPMC_SHMEM_BLOCK_ALIGN);
+
+	if ((state->data == NULL) ||
+	    (state->data_size < SPMC_SHMEM_MIN_BLOCK_SIZE)) {
+		return;
+	}
+
+	assert(is_aligned((uintptr_t)state->data, sizeof(uint64_t)));
+
+	blk = (struct spmc_shmem_obj *)state->data;
+	blk->block_size = state->data_size;
+	blk->next = NULL;
+	blk->free = true;
+	state->free_list = blk;
+}
+
 /**
  * spmc_shmem_obj_alloc - Allocate struct spmc_shmem_obj.
  * @state:      Global state.
  * @desc_size:  Size of struct ffa_memory_region_descriptor object that
  *              allocated object will hold.
  *
+ * Take the first free block large enough from the address ordered free list,
+ * splitting off the unused part of the block if it is big enough to hold
+ * another object.
+ *
  * Return: Pointer to newly allocated object, or %NULL if there not enough space
  *         left. The returned pointer is only valid while @state is locked, to
  *         used it again after unlocking @state, spmc_shmem_obj_lookup must be
@@ -72,6 +144,8 @@ static struct spmc_shmem_obj *
 spmc_shmem_obj_alloc(struct spmc_shmem_obj_state *state, size_t desc_size)
 {
 	struct spmc_shmem_obj *obj;
+	struct spmc_shmem_obj *rem;
+	struct spmc_shmem_obj **prev;
 	size_t free = state->data_size - state->allocated;
 	size_t obj_size;
 
@@ -90,51 +164,126 @@ spmc_shmem_obj_alloc(struct spmc_shmem_obj_state *state, size_t desc_size)
 	obj_size = spmc_shmem_obj_size(desc_size);
 
 	/* Ensure the obj size has not overflowed. */
-	if (obj_size < desc_size) {
+	if ((obj_size < desc_size) ||
+	    (obj_size > (SIZE_MAX - SPMC_SHMEM_BLOCK_ALIGN))) {
 		WARN("%s(0x%zx) desc_size overflow\n",
 		     __func__, desc_size);
 		return NULL;
 	}
+	obj_size = MAX(round_up(obj_size, SPMC_SHMEM_BLOCK_ALIGN),
+		       SPMC_SHMEM_MIN_BLOCK_SIZE);
 
-	if (obj_size > free) {
+	for (prev = &state->free_list; *prev != NULL; prev = &(*prev)->next) {
+		if ((*prev)->block_size >= obj_size) {
+			break;
+		}
+	}
+
+	if (*prev == NULL) {
 		WARN("%s(0x%zx) failed, free 0x%zx\n",
 		     __func__, desc_size, free);
 		return NULL;
 	}
-	obj = (struct spmc_shmem_obj *)(state->data + state->allocated);
+
+	obj = *prev;
+	if ((obj->block_size - obj_size) >= SPMC_SHMEM_MIN_BLOCK_SIZE) {
+		rem = (struct spmc_shmem_obj *)((uint8_t *)obj + obj_size);
+		rem->block_size = obj->block_size - obj_size;
+		rem->next = obj->next;
+		rem->free = true;
+		obj->block_size = obj_size;
+		*prev = rem;
+	} else {
+		*prev = obj->next;
+	}
+
+	obj->free = false;
+	obj->next = NULL;
 	obj->desc = (struct ffa_mtd) {0};
 	obj->desc_size = desc_size;
 	obj->desc_filled = 0;
 	obj->in_use = 0;
-	state->allocated += obj_size;
+	state->allocated += obj->block_size;
+
 	return obj;
 }
 
+/**
+ * spmc_shmem_obj_publish - Make an object visible to spmc_shmem_obj_lookup.
+ * @state:      Global state.
+ * @obj:        Object, as returned by spmc_shmem_obj_alloc, with its final
+ *              handle set in @obj->desc.handle.
+ *
+ * Objects are only added to the handle hash table once their handle is
+ * known, so that temporary objects used for descriptor conversion never
+ * shadow the object they were converted from.
+ */
+static void spmc_shmem_obj_publish(struct spmc_shmem_obj_state *state,
+				   struct spmc_shmem_obj *obj)
+{
+	struct spmc_shmem_obj **bucket = spmc_shmem_obj_hash(state,
+							     obj->desc.handle);
+
+	obj->next = *bucket;
+	*bucket = obj;
+}
+
 /**
  * spmc_shmem_obj_free - Free struct spmc_shmem_obj.
  * @state:      Global state.
  * @obj:        Object to free.
  *
- * Release memory used by @obj. Other objects may move, so on return all
- * pointers to struct spmc_shmem_obj object should be considered invalid, not
- * just @obj.
+ * Release memory used by @obj. Other objects do not move, but @obj must not be
+ * used after this call.
  *
- * The current implementation always compacts the remaining objects to simplify
- * the allocator and to avoid fragmentation.
+ * The block is returned to the address ordered free list and merged with the
+ * free blocks directly before and after it to limit fragmentation.
  */
 
 static void spmc_shmem_obj_free(struct spmc_shmem_obj_state *state,
 				  struct spmc_shmem_obj *obj)
 {
-	size_t free_size = spmc_shmem_obj_size(obj->desc_size);
-	uint8_t *shift_dest = (uint8_t *)obj;
-	uint8_t *shift_src = shift_dest + free_size;
-	size_t shift_size = state->allocated - (shift_src - state->data);
+	struct spmc_shmem_obj **prev;
+	struct spmc_shmem_obj *before = NULL;
+	struct spmc_shmem_obj *after;
+
+	assert(!obj->free);
+
+	/* Unlink from the handle hash table, if it was published. */
+	for (prev = spmc_shmem_obj_hash(state, obj->desc.handle);
+	     *prev != NULL; prev = &(*prev)->next) {
+		if (*prev == obj) {
+			*prev = obj->next;
+			break;
+		}
+	}
+
+	state->allocated -= obj->block_size;
+	obj->free = true;
+
+	/* Find the free blocks around @obj. */
+	for (prev = &state->free_list; (*prev != NULL) && (*prev < obj);
+	     prev = &(*prev)->next) {
+		before = *prev;
+	}
+	after = *prev;
+
+	/* Insert, merging with the following block if adjacent. */
+	if ((after != NULL) &&
+	    ((uint8_t *)obj + obj->block_size == (uint8_t *)after)) {
+		obj->block_size += after->block_size;
+		obj->next = after->next;
+	} else {
+		obj->next = after;
+	}
+	*prev = obj;
 
-	if (shift_size != 0U) {
-		memmove(shift_dest, shift_src, shift_size);
+	/* Merge with the preceding block if adjacent. */
+	if ((before != NULL) &&
+	    ((uint8_t *)before + before->block_size == (uint8_t *)obj)) {
+		before->block_size += obj->block_size;
+		before->next = obj->next;
 	}
-	state->allocated -= free_size;
 }
 
 /**
@@ -148,15 +297,13 @@ static void spmc_shmem_obj_free(struct spmc_shmem_obj_state *state,
 static struct spmc_shmem_obj *
 spmc_shmem_obj_lookup(struct spmc_shmem_obj_state *state, uint64_t handle)
 {
-	uint8_t *curr = state->data;
-
-	while (curr - state->data < state->allocated) {
-		struct spmc_shmem_obj *obj = (struct spmc_shmem_obj *)curr;
+	struct spmc_shmem_obj *obj = *spmc_shmem_obj_hash(state, handle);
 
+	while (obj != NULL) {
 		if (obj->desc.handle == handle) {
 			return obj;
 		}
-		curr += spmc_shmem_obj_size(obj->desc_size);
+		obj = obj->next;
 	}
 	return NULL;
 }
@@ -175,12 +322,16 @@ spmc_shmem_obj_get_next(struct spmc_shmem_obj_state *state, size_t *offset)
 {
 	uint8_t *curr = state->data + *offset;
 
-	if (curr - state->data < state->allocated) {
+	while ((state->allocated != 0U) &&
+	       (curr - state->data < state->data_size)) {
 		struct spmc_shmem_obj *obj = (struct spmc_shmem_obj *)curr;
 
-		*offset += spmc_shmem_obj_size(obj->desc_size);
+		*offset += obj->block_size;
+		curr += obj->block_size;
 
-		return obj;
+		if (!obj->free) {
+			return obj;
+		}
 	}
 	return NULL;
 }
@@ -632,8 +783,6 @@ spmc_shm_convert_mtd_to_v1_0(struct spmc_shmem_obj *out_obj,
  *                  descriptor.
  *
  * Return: 0 if conversion and population succeeded.
- * Note: This function invalidates the reference to @orig therefore
- * `spmc_shmem_obj_lookup` must be called if further usage is required.
  */
 static uint32_t
 spmc_populate_ffa_v1_0_descriptor(void *dst, struct spmc_shmem_obj *orig_obj,
@@ -669,11 +818,7 @@ spmc_populate_ffa_v1_0_descriptor(void *dst, struct spmc_shmem_obj *orig_obj,
 		*copy_size = MIN(v1_0_obj->desc_size - offset, buf_size);
 		memcpy(dst, (uint8_t *) &v1_0_obj->desc + offset, *copy_size);
 
-		/*
-		 * We're finished with the v1.0 descriptor for now so free it.
-		 * Note that this will invalidate any references to the v1.1
-		 * descriptor.
-		 */
+		/* We're finished with the v1.0 descriptor for now so free it. */
 		spmc_shmem_obj_free(&spmc_shmem_obj_state, v1_0_obj);
 
 		return 0;
@@ -1069,6 +1214,7 @@ static long spmc_ffa_fill_desc(struct mailbox *mbox,
 		}
 
 		obj->desc.handle = spmc_shmem_obj_state.next_handle++;
+		spmc_shmem_obj_publish(&spmc_shmem_obj_state, obj);
 		obj->desc.flags |= mtd_flag;
 	}
 
@@ -1138,6 +1284,7 @@ static long spmc_ffa_fill_desc(struct mailbox *mbox,
 		 */
 		mem_handle = obj->desc.handle;
 		spmc_shmem_obj_free(&spmc_shmem_obj_state, obj);
+		spmc_shmem_obj_publish(&spmc_shmem_obj_state, v1_1_obj);
 		obj = spmc_shmem_obj_lookup(&spmc_shmem_obj_state, mem_handle);
 		if (obj == NULL) {
 			ERROR("%s: Failed to find converted descriptor.\n",
@@ -31,12 +31,21 @@ struct ffa_mem_relinquish_descriptor {
 CASSERT(sizeof(struct ffa_mem_relinquish_descriptor) == 16,
 	assert_ffa_mem_relinquish_descriptor_size_mismatch);
 
+/* Number of buckets of the handle hash table, must be a power of 2. */
+#ifndef SPMC_SHMEM_OBJ_HASH_SIZE
+#define SPMC_SHMEM_OBJ_HASH_SIZE	64
+#endif
+
+struct spmc_shmem_obj;
+
 /**
  * struct spmc_shmem_obj_state - Global state.
  * @data:           Backing store for spmc_shmem_obj objects.
  * @data_size:      The size allocated for the backing store.
  * @allocated:      Number of bytes allocated in @data.
  * @next_handle:    Handle used for next allocated object.
+ * @free_list:      Free blocks of @data, in address order.
+ * @hash:           Allocated objects, hashed by handle.
  * @lock:           Lock protecting all state in this file.
  */
 struct spmc_shmem_obj_state {
@@ -44,10 +53,13 @@ struct spmc_shmem_obj_state {
 	size_t data_size;
 	size_t allocated;
 	uint64_t next_handle;
+	struct spmc_shmem_obj *free_list;
+	struct spmc_shmem_obj *hash[SPMC_SHMEM_OBJ_HASH_SIZE];
 	spinlock_t lock;
 };
 
 extern struct spmc_shmem_obj_state spmc_shmem_obj_state;
+void spmc_shmem_obj_state_init(struct spmc_shmem_obj_state *state);
 extern int plat_spmc_shmem_begin(struct ffa_mtd *desc);
 extern int plat_spmc_shmem_reclaim(struct ffa_mtd *desc);
 
@@ -195,7 +195,7 @@ uint64_t spm_mm_sp_call(uint32_t smc_fid, uint64_t x1, uint64_t x2, uint64_t x3)
 	 * SP runs to completion, no need to restore FP registers of secure context.
 	 * Save FP registers only for non secure context.
 	 */
-	fpregs_context_save(get_fpregs_ctx(cm_get_context(NON_SECURE)));
+	cm_fpregs_context_save(NON_SECURE);
 #endif
 
 	/* Wait until the Secure Partition is idle and set it to busy. */
@@ -221,7 +221,7 @@ uint64_t spm_mm_sp_call(uint32_t smc_fid, uint64_t x1, uint64_t x2, uint64_t x3)
 	 * SP runs to completion, no need to save FP registers of secure context.
 	 * Restore only non secure world FP registers.
 	 */
-	fpregs_context_restore(get_fpregs_ctx(cm_get_context(NON_SECURE)));
+	cm_fpregs_context_restore(NON_SECURE);
 #endif
 
 	return rc;
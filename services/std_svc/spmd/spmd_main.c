@@ -51,6 +51,12 @@ static spmc_manifest_attribute_t spmc_attrs;
  ******************************************************************************/
 static entry_point_info_t *spmc_ep_info;
 
+/*******************************************************************************
+ * FF-A version negotiated by the Normal world through FFA_VERSION. Zero until
+ * the Normal world has called FFA_VERSION.
+ ******************************************************************************/
+static uint32_t nwd_ffa_version;
+
 /*******************************************************************************
  * SPM Core context on CPU based on mpidr.
  ******************************************************************************/
@@ -67,11 +73,16 @@ spmd_spm_core_context_t *spmd_get_context_by_mpidr(uint64_t mpidr)
 }
 
 /*******************************************************************************
- * SPM Core context on current CPU get helper.
+ * SPM Core context on current CPU get helper. This is called on every SMC, so
+ * the linear index of the current CPU is used rather than validating its MPIDR.
  ******************************************************************************/
 spmd_spm_core_context_t *spmd_get_context(void)
 {
-	return spmd_get_context_by_mpidr(read_mpidr());
+	unsigned int core_idx = plat_my_core_pos();
+
+	assert(core_idx < PLATFORM_CORE_COUNT);
+
+	return &spm_core_context[core_idx];
 }
 
 /*******************************************************************************
@@ -659,15 +670,10 @@ int spmd_setup(void)
 }
 
 /*******************************************************************************
- * Forward FF-A SMCs to the other security state.
+ * Save the system register context of the security state the SMC came from
+ * and restore that of the other one, which the SMC is forwarded to.
  ******************************************************************************/
-uint64_t spmd_smc_switch_state(uint32_t smc_fid,
-			       bool secure_origin,
-			       uint64_t x1,
-			       uint64_t x2,
-			       uint64_t x3,
-			       uint64_t x4,
-			       void *handle)
+static void spmd_switch_sysregs_context(bool secure_origin)
 {
 	unsigned int secure_state_in = (secure_origin) ? SECURE : NON_SECURE;
 	unsigned int secure_state_out = (!secure_origin) ? SECURE : NON_SECURE;
@@ -680,6 +686,13 @@ uint64_t spmd_smc_switch_state(uint32_t smc_fid,
 	cm_el2_sysregs_context_save(secure_state_in);
 #else
 	cm_el1_sysregs_context_save(secure_state_in);
+#if CTX_LAZY_FPREGS
+	/*
+	 * Only records which world is to own the FP registers: they are
+	 * switched on its first FP/SIMD access, if any.
+	 */
+	cm_fpregs_context_save(secure_state_in);
+#endif
 #endif
 
 	/* Restore outgoing security state */
@@ -690,8 +703,31 @@ uint64_t spmd_smc_switch_state(uint32_t smc_fid,
 	cm_el2_sysregs_context_restore(secure_state_out);
 #else
 	cm_el1_sysregs_context_restore(secure_state_out);
+#if CTX_LAZY_FPREGS
+	cm_fpregs_context_restore(secure_state_out);
+#endif
 #endif
 	cm_set_next_eret_context(secure_state_out);
+}
+
+/*******************************************************************************
+ * Forward FF-A SMCs to the other security state. x0-x7 are always copied. When
+ * the SPMC is at S-EL2, x8-x17 are copied as well, both ways: FF-A v1.2 ABIs
+ * such as FFA_MSG_SEND_DIRECT_REQ2 carry arguments in them, and for the other
+ * ABIs SMCCC requires them to be preserved, which the SPMC does by handing back
+ * the values it was given. spmd_direct_msg_forward() relies on the latter.
+ ******************************************************************************/
+uint64_t spmd_smc_switch_state(uint32_t smc_fid,
+			       bool secure_origin,
+			       uint64_t x1,
+			       uint64_t x2,
+			       uint64_t x3,
+			       uint64_t x4,
+			       void *handle)
+{
+	unsigned int secure_state_out = (!secure_origin) ? SECURE : NON_SECURE;
+
+	spmd_switch_sysregs_context(secure_origin);
 
 #if SPMD_SPM_AT_SEL2
 	/*
@@ -751,6 +787,44 @@ static uint64_t spmd_smc_forward(uint32_t smc_fid,
 
 }
 
+/*******************************************************************************
+ * Forward FF-A direct messages to the other security state. Before FF-A v1.2
+ * they only carry arguments in x0-x7. The SPMC at S-EL2 hands back the x8-x17
+ * it was given by the Normal world, and these are still in the Normal world
+ * context since its last SMC, so only x0-x7 are copied on the way to the
+ * Normal world. Once the Normal world has negotiated FF-A v1.2 or later, the
+ * whole of x0-x17 is copied as spmd_smc_switch_state() does, so that nothing
+ * depends on the SPMC preserving x8-x17. The other way, the SPMC expects
+ * x8-x17 as spmd_smc_switch_state() passes them.
+ ******************************************************************************/
+static uint64_t spmd_direct_msg_forward(uint32_t smc_fid,
+					bool secure_origin,
+					uint64_t x1,
+					uint64_t x2,
+					uint64_t x3,
+					uint64_t x4,
+					void *cookie,
+					void *handle,
+					uint64_t flags)
+{
+	if (!secure_origin) {
+		return spmd_smc_forward(smc_fid, secure_origin, x1, x2, x3, x4,
+					cookie, handle, flags);
+	}
+
+	if (nwd_ffa_version >= MAKE_FFA_VERSION(1, 2)) {
+		return spmd_smc_switch_state(smc_fid, secure_origin, x1, x2,
+					     x3, x4, handle);
+	}
+
+	spmd_switch_sysregs_context(secure_origin);
+
+	SMC_RET8(cm_get_context(NON_SECURE), smc_fid, x1, x2, x3, x4,
+		 SMC_GET_GP(handle, CTX_GPREG_X5),
+		 SMC_GET_GP(handle, CTX_GPREG_X6),
+		 SMC_GET_GP(handle, CTX_GPREG_X7));
+}
+
 /*******************************************************************************
  * Return FFA_ERROR with specified error code
  ******************************************************************************/
@@ -927,6 +1001,8 @@ uint64_t spmd_smc_handler(uint32_t smc_fid,
 			    spmc_attrs.minor_version == 0) {
 				ret = MAKE_FFA_VERSION(spmc_attrs.major_version,
 						       spmc_attrs.minor_version);
+				nwd_ffa_version = MIN(input_version,
+						      (uint32_t)ret);
 				SMC_RET8(handle, (uint32_t)ret,
 					 FFA_TARGET_INFO_MBZ,
 					 FFA_TARGET_INFO_MBZ,
@@ -980,6 +1056,15 @@ uint64_t spmd_smc_handler(uint32_t smc_fid,
 				ret = SMC_GET_GP(gpregs, CTX_GPREG_X3);
 			}
 
+			/*
+			 * The Normal world uses the lower of the version it
+			 * asked for and the version of the SPMC.
+			 */
+			if (ret != FFA_ERROR_NOT_SUPPORTED) {
+				nwd_ffa_version = MIN(input_version,
+						      (uint32_t)ret);
+			}
+
 			/*
 			 * x0-x4 are updated by spmd_smc_forward below.
 			 * Zero out x5-x7 in the FFA_VERSION response.
@@ -1145,9 +1230,9 @@ uint64_t spmd_smc_handler(uint32_t smc_fid,
 				FFA_PARAM_MBZ);
 		} else {
 			/* Forward direct message to the other world */
-			return spmd_smc_forward(smc_fid, secure_origin,
-						x1, x2, x3, x4, cookie,
-						handle, flags);
+			return spmd_direct_msg_forward(smc_fid, secure_origin,
+						       x1, x2, x3, x4, cookie,
+						       handle, flags);
 		}
 		break; /* Not reached */
 
@@ -1158,9 +1243,9 @@ uint64_t spmd_smc_handler(uint32_t smc_fid,
 			spmd_spm_core_sync_exit(0ULL);
 		} else {
 			/* Forward direct message to the other world */
-			return spmd_smc_forward(smc_fid, secure_origin,
-						x1, x2, x3, x4, cookie,
-						handle, flags);
+			return spmd_direct_msg_forward(smc_fid, secure_origin,
+						       x1, x2, x3, x4, cookie,
+						       handle, flags);
 		}
 		break; /* Not reached */
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2022, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -25,6 +25,7 @@
 #include "ext.h"
 #include "key.h"
 #include "sha.h"
+#include "tool_jobs.h"
 
 /*
  * Helper macros to simplify the code. This macro assigns the return value of
@@ -65,6 +66,14 @@ static int key_size;
 static int new_keys;
 static int save_keys;
 static int print_cert;
+static int num_jobs;
+
+/* Image hash algorithm, as indicated in the certificate extensions */
+static const EVP_MD *md_info;
+static unsigned int md_len;
+
+/* Hashes of the files given to the hash extensions, indexed like extensions[] */
+static unsigned char (*ext_md)[SHA512_DIGEST_LENGTH];
 
 /* Info messages created in the Makefile */
 extern const char build_msg[];
@@ -261,6 +270,189 @@ static void check_cmd_params(void)
 	}
 }
 
+static void hash_ext(void *arg, int i)
+{
+	int idx = ((const int *)arg)[i];
+	ext_t *ext = &extensions[idx];
+
+	if (!sha_file(hash_alg, ext->arg, ext_md[idx])) {
+		ERROR("Cannot calculate hash of %s\n", ext->arg);
+		exit(1);
+	}
+}
+
+/*
+ * Hash the images of the requested certificates, each one once even if it goes
+ * in several certificates.
+ */
+static void hash_images(void)
+{
+	cert_t *cert;
+	ext_t *ext;
+	int *idx;
+	bool *hashed;
+	int i, j, num = 0;
+
+	CHECK_NULL(ext_md, calloc(num_extensions, sizeof(ext_md[0])));
+	CHECK_NULL(idx, malloc(num_extensions * sizeof(idx[0])));
+	CHECK_NULL(hashed, calloc(num_extensions, sizeof(hashed[0])));
+
+	for (i = 0 ; i < num_certs ; i++) {
+		cert = &certs[i];
+		if (cert->fn == NULL) {
+			continue;
+		}
+
+		for (j = 0 ; j < cert->num_ext ; j++) {
+			ext = &extensions[cert->ext[j]];
+			if ((ext->type == EXT_TYPE_HASH) && (ext->arg != NULL) &&
+			    !hashed[cert->ext[j]]) {
+				hashed[cert->ext[j]] = true;
+				idx[num++] = cert->ext[j];
+			}
+		}
+	}
+
+	tool_jobs_run(num_jobs, hash_ext, idx, num);
+
+	free(hashed);
+	free(idx);
+}
+
+static void create_cert(void *arg, int i)
+{
+	int idx = ((const int *)arg)[i];
+	STACK_OF(X509_EXTENSION) * sk;
+	X509_EXTENSION *cert_ext = NULL;
+	cert_t *cert = &certs[idx];
+	ext_t *ext;
+	int j, ext_nid, nvctr;
+	unsigned char zero_md[SHA512_DIGEST_LENGTH] = { 0 };
+	unsigned char *md;
+
+	/* Create a new stack of extensions. This stack will be used
+	 * to create the certificate */
+	CHECK_NULL(sk, sk_X509_EXTENSION_new_null());
+
+	for (j = 0 ; j < cert->num_ext ; j++) {
+
+		ext = &extensions[cert->ext[j]];
+
+		/* Get OpenSSL internal ID for this extension */
+		CHECK_OID(ext_nid, ext->oid);
+
+		/*
+		 * Three types of extensions are currently supported:
+		 *     - EXT_TYPE_NVCOUNTER
+		 *     - EXT_TYPE_HASH
+		 *     - EXT_TYPE_PKEY
+		 */
+		switch (ext->type) {
+		case EXT_TYPE_NVCOUNTER:
+			if (ext->optional && ext->arg == NULL) {
+				/* Skip this NVCounter */
+				continue;
+			} else {
+				/* Checked by `check_cmd_params` */
+				assert(ext->arg != NULL);
+				nvctr = atoi(ext->arg);
+				CHECK_NULL(cert_ext, ext_new_nvcounter(ext_nid,
+					EXT_CRIT, nvctr));
+			}
+			break;
+		case EXT_TYPE_HASH:
+			if (ext->arg == NULL) {
+				if (ext->optional) {
+					/* Include a hash filled with zeros */
+					md = zero_md;
+				} else {
+					/* Do not include this hash in the certificate */
+					continue;
+				}
+			} else {
+				/* Calculated by hash_images() */
+				md = ext_md[cert->ext[j]];
+			}
+			CHECK_NULL(cert_ext, ext_new_hash(ext_nid,
+					EXT_CRIT, md_info, md,
+					md_len));
+			break;
+		case EXT_TYPE_PKEY:
+			CHECK_NULL(cert_ext, ext_new_key(ext_nid,
+				EXT_CRIT, keys[ext->attr.key].key));
+			break;
+		default:
+			ERROR("Unknown extension type '%d' in %s\n",
+					ext->type, cert->cn);
+			exit(1);
+		}
+
+		/* Push the extension into the stack */
+		sk_X509_EXTENSION_push(sk, cert_ext);
+	}
+
+	/* Create certificate. Signed with corresponding key */
+	if (!cert_new(hash_alg, cert, VAL_DAYS, 0, sk)) {
+		ERROR("Cannot create %s\n", cert->cn);
+		exit(1);
+	}
+
+	for (cert_ext = sk_X509_EXTENSION_pop(sk); cert_ext != NULL;
+			cert_ext = sk_X509_EXTENSION_pop(sk)) {
+		X509_EXTENSION_free(cert_ext);
+	}
+
+	sk_X509_EXTENSION_free(sk);
+}
+
+/*
+ * Create the requested certificates, signing the independent ones concurrently.
+ * cert_new() takes the issuer details from the issuer certificate if it has
+ * already been created, so of a certificate and its issuer the one that comes
+ * first in certs[] is created in an earlier round, as it was when certificates
+ * were created one after the other.
+ */
+static void create_certs(void)
+{
+	int *round, *idx;
+	int i, k, r, num, num_rounds = 0;
+
+	CHECK_NULL(round, calloc(num_certs, sizeof(round[0])));
+	CHECK_NULL(idx, malloc(num_certs * sizeof(idx[0])));
+
+	for (i = 0 ; i < num_certs ; i++) {
+		if (certs[i].fn == NULL) {
+			continue;
+		}
+
+		for (k = 0 ; k < i ; k++) {
+			if ((certs[k].fn != NULL) &&
+			    ((certs[i].issuer == k) || (certs[k].issuer == i)) &&
+			    (round[i] <= round[k])) {
+				round[i] = round[k] + 1;
+			}
+		}
+
+		if (round[i] >= num_rounds) {
+			num_rounds = round[i] + 1;
+		}
+	}
+
+	for (r = 0 ; r < num_rounds ; r++) {
+		num = 0;
+		for (i = 0 ; i < num_certs ; i++) {
+			if ((certs[i].fn != NULL) && (round[i] == r)) {
+				idx[num++] = i;
+			}
+		}
+
+		tool_jobs_run(num_jobs, create_cert, idx, num);
+	}
+
+	free(idx);
+	free(round);
+}
+
 /* Common command line options */
 static const cmd_opt_t common_cmd_opt[] = {
 	{
@@ -280,6 +472,11 @@ static const cmd_opt_t common_cmd_opt[] = {
 		{ "hash-alg", required_argument, NULL, 's' },
 		"Hash algorithm : 'sha256' (default), 'sha384', 'sha512'"
 	},
+	{
+		{ "jobs", required_argument, NULL, 'j' },
+		"Number of threads hashing the images and signing the " \
+		"certificates (default: number of online CPUs)"
+	},
 	{
 		{ "save-keys", no_argument, NULL, 'k' },
 		"Save key pairs into files. Filenames must be provided"
@@ -296,20 +493,15 @@ static const cmd_opt_t common_cmd_opt[] = {
 
 int main(int argc, char *argv[])
 {
-	STACK_OF(X509_EXTENSION) * sk;
-	X509_EXTENSION *cert_ext = NULL;
 	ext_t *ext;
 	key_t *key;
 	cert_t *cert;
 	FILE *file;
-	int i, j, ext_nid, nvctr;
+	int i;
 	int c, opt_idx = 0;
 	const struct option *cmd_opt;
 	const char *cur_opt;
 	unsigned int err_code;
-	unsigned char md[SHA512_DIGEST_LENGTH];
-	unsigned int  md_len;
-	const EVP_MD *md_info;
 
 	NOTICE("CoT Generation Tool: %s\n", build_msg);
 	NOTICE("Target platform: %s\n", platform_msg);
@@ -318,6 +510,7 @@ int main(int argc, char *argv[])
 	key_alg = KEY_ALG_RSA;
 	hash_alg = HASH_ALG_SHA256;
 	key_size = -1;
+	num_jobs = -1;
 
 	/* Add common command line options */
 	for (i = 0; i < NUM_ELEM(common_cmd_opt); i++) {
@@ -347,7 +540,7 @@ int main(int argc, char *argv[])
 
 	while (1) {
 		/* getopt_long stores the option index here. */
-		c = getopt_long(argc, argv, "a:b:hknps:", cmd_opt, &opt_idx);
+		c = getopt_long(argc, argv, "a:b:hj:knps:", cmd_opt, &opt_idx);
 
 		/* Detect the end of the options. */
 		if (c == -1) {
@@ -372,6 +565,13 @@ int main(int argc, char *argv[])
 		case 'h':
 			print_help(argv[0], cmd_opt);
 			exit(0);
+		case 'j':
+			num_jobs = tool_jobs_parse(optarg);
+			if (num_jobs <= 0) {
+				ERROR("Invalid number of jobs '%s'\n", optarg);
+				exit(1);
+			}
+			break;
 		case 'k':
 			save_keys = 1;
 			break;
@@ -415,6 +615,11 @@ int main(int argc, char *argv[])
 		key_size = KEY_SIZES[key_alg][0];
 	}
 
+	/* Use one thread per CPU by default */
+	if (num_jobs == -1) {
+		num_jobs = tool_jobs_default();
+	}
+
 	/* Check command line arguments */
 	check_cmd_params();
 
@@ -474,95 +679,9 @@ int main(int argc, char *argv[])
 		}
 	}
 
-	/* Create the certificates */
-	for (i = 0 ; i < num_certs ; i++) {
-
-		cert = &certs[i];
-
-		if (cert->fn == NULL) {
-			/* Certificate not requested. Skip to the next one */
-			continue;
-		}
-
-		/* Create a new stack of extensions. This stack will be used
-		 * to create the certificate */
-		CHECK_NULL(sk, sk_X509_EXTENSION_new_null());
-
-		for (j = 0 ; j < cert->num_ext ; j++) {
-
-			ext = &extensions[cert->ext[j]];
-
-			/* Get OpenSSL internal ID for this extension */
-			CHECK_OID(ext_nid, ext->oid);
-
-			/*
-			 * Three types of extensions are currently supported:
-			 *     - EXT_TYPE_NVCOUNTER
-			 *     - EXT_TYPE_HASH
-			 *     - EXT_TYPE_PKEY
-			 */
-			switch (ext->type) {
-			case EXT_TYPE_NVCOUNTER:
-				if (ext->optional && ext->arg == NULL) {
-					/* Skip this NVCounter */
-					continue;
-				} else {
-					/* Checked by `check_cmd_params` */
-					assert(ext->arg != NULL);
-					nvctr = atoi(ext->arg);
-					CHECK_NULL(cert_ext, ext_new_nvcounter(ext_nid,
-						EXT_CRIT, nvctr));
-				}
-				break;
-			case EXT_TYPE_HASH:
-				if (ext->arg == NULL) {
-					if (ext->optional) {
-						/* Include a hash filled with zeros */
-						memset(md, 0x0, SHA512_DIGEST_LENGTH);
-					} else {
-						/* Do not include this hash in the certificate */
-						continue;
-					}
-				} else {
-					/* Calculate the hash of the file */
-					if (!sha_file(hash_alg, ext->arg, md)) {
-						ERROR("Cannot calculate hash of %s\n",
-							ext->arg);
-						exit(1);
-					}
-				}
-				CHECK_NULL(cert_ext, ext_new_hash(ext_nid,
-						EXT_CRIT, md_info, md,
-						md_len));
-				break;
-			case EXT_TYPE_PKEY:
-				CHECK_NULL(cert_ext, ext_new_key(ext_nid,
-					EXT_CRIT, keys[ext->attr.key].key));
-				break;
-			default:
-				ERROR("Unknown extension type '%d' in %s\n",
-						ext->type, cert->cn);
-				exit(1);
-			}
-
-			/* Push the extension into the stack */
-			sk_X509_EXTENSION_push(sk, cert_ext);
-		}
-
-		/* Create certificate. Signed with corresponding key */
-		if (!cert_new(hash_alg, cert, VAL_DAYS, 0, sk)) {
-			ERROR("Cannot create %s\n", cert->cn);
-			exit(1);
-		}
-
-		for (cert_ext = sk_X509_EXTENSION_pop(sk); cert_ext != NULL;
-				cert_ext = sk_X509_EXTENSION_pop(sk)) {
-			X509_EXTENSION_free(cert_ext);
-		}
-
-		sk_X509_EXTENSION_free(sk);
-	}
-
+	/* Hash the images, then create the certificates */
+	hash_images();
+	create_certs();
 
 	/* Print the certificates */
 	if (print_cert) {
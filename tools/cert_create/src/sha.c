@@ -1,10 +1,19 @@
 /*
- * Copyright (c) 2015-2022, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+/* Needed by fileno() and posix_madvise() with -std=c99 */
+#define _POSIX_C_SOURCE	200112L
+
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 #include "debug.h"
 #include "key.h"
 #if USING_OPENSSL3
@@ -14,7 +23,18 @@
 #include <openssl/sha.h>
 #endif
 
-#define BUFFER_SIZE	256
+/* Size of the reads of the files that cannot be mapped */
+#define BUFFER_SIZE	(1024 * 1024)
+
+typedef struct sha_ctx {
+#if USING_OPENSSL3
+	EVP_MD_CTX *mdctx;
+#else
+	int md_alg;
+	SHA256_CTX sha256;
+	SHA512_CTX sha512;
+#endif
+} sha_ctx_t;
 
 #if USING_OPENSSL3
 static int get_algorithm_nid(int hash_alg)
@@ -27,37 +47,14 @@ static int get_algorithm_nid(int hash_alg)
 }
 #endif
 
-int sha_file(int md_alg, const char *filename, unsigned char *md)
+static int sha_init(sha_ctx_t *ctx, int md_alg)
 {
-	FILE *inFile;
-	int bytes;
-	unsigned char data[BUFFER_SIZE];
 #if USING_OPENSSL3
-	EVP_MD_CTX *mdctx;
 	const EVP_MD *md_type;
 	int alg_nid;
-	unsigned int total_bytes;
-#else
-	SHA256_CTX shaContext;
-	SHA512_CTX sha512Context;
-#endif
 
-	if ((filename == NULL) || (md == NULL)) {
-		ERROR("%s(): NULL argument\n", __func__);
-		return 0;
-	}
-
-	inFile = fopen(filename, "rb");
-	if (inFile == NULL) {
-		ERROR("Cannot read %s\n", filename);
-		return 0;
-	}
-
-#if USING_OPENSSL3
-
-	mdctx = EVP_MD_CTX_new();
-	if (mdctx == NULL) {
-		fclose(inFile);
+	ctx->mdctx = EVP_MD_CTX_new();
+	if (ctx->mdctx == NULL) {
 		ERROR("%s(): Could not create EVP MD context\n", __func__);
 		return 0;
 	}
@@ -69,50 +66,143 @@ int sha_file(int md_alg, const char *filename, unsigned char *md)
 	}
 
 	md_type = EVP_get_digestbynid(alg_nid);
-	if (EVP_DigestInit_ex(mdctx, md_type, NULL) == 0) {
+	if (EVP_DigestInit_ex(ctx->mdctx, md_type, NULL) == 0) {
 		ERROR("%s(): Could not initialize EVP MD digest\n", __func__);
 		goto err;
 	}
 
-	while ((bytes = fread(data, 1, BUFFER_SIZE, inFile)) != 0) {
-		EVP_DigestUpdate(mdctx, data, bytes);
-	}
-	EVP_DigestFinal_ex(mdctx, md, &total_bytes);
-
-	fclose(inFile);
-	EVP_MD_CTX_free(mdctx);
 	return 1;
 
 err:
-	fclose(inFile);
-	EVP_MD_CTX_free(mdctx);
+	EVP_MD_CTX_free(ctx->mdctx);
 	return 0;
-
 #else
-
+	ctx->md_alg = md_alg;
 	if (md_alg == HASH_ALG_SHA384) {
-		SHA384_Init(&sha512Context);
-		while ((bytes = fread(data, 1, BUFFER_SIZE, inFile)) != 0) {
-			SHA384_Update(&sha512Context, data, bytes);
-		}
-		SHA384_Final(md, &sha512Context);
+		SHA384_Init(&ctx->sha512);
 	} else if (md_alg == HASH_ALG_SHA512) {
-		SHA512_Init(&sha512Context);
-		while ((bytes = fread(data, 1, BUFFER_SIZE, inFile)) != 0) {
-			SHA512_Update(&sha512Context, data, bytes);
-		}
-		SHA512_Final(md, &sha512Context);
+		SHA512_Init(&ctx->sha512);
 	} else {
-		SHA256_Init(&shaContext);
-		while ((bytes = fread(data, 1, BUFFER_SIZE, inFile)) != 0) {
-			SHA256_Update(&shaContext, data, bytes);
-		}
-		SHA256_Final(md, &shaContext);
+		SHA256_Init(&ctx->sha256);
 	}
 
-	fclose(inFile);
 	return 1;
+#endif
+}
+
+static void sha_update(sha_ctx_t *ctx, const void *data, size_t len)
+{
+#if USING_OPENSSL3
+	EVP_DigestUpdate(ctx->mdctx, data, len);
+#else
+	if (ctx->md_alg == HASH_ALG_SHA384) {
+		SHA384_Update(&ctx->sha512, data, len);
+	} else if (ctx->md_alg == HASH_ALG_SHA512) {
+		SHA512_Update(&ctx->sha512, data, len);
+	} else {
+		SHA256_Update(&ctx->sha256, data, len);
+	}
+#endif
+}
+
+static void sha_final(sha_ctx_t *ctx, unsigned char *md)
+{
+#if USING_OPENSSL3
+	unsigned int total_bytes;
+
+	EVP_DigestFinal_ex(ctx->mdctx, md, &total_bytes);
+	EVP_MD_CTX_free(ctx->mdctx);
+#else
+	if (ctx->md_alg == HASH_ALG_SHA384) {
+		SHA384_Final(md, &ctx->sha512);
+	} else if (ctx->md_alg == HASH_ALG_SHA512) {
+		SHA512_Final(md, &ctx->sha512);
+	} else {
+		SHA256_Final(md, &ctx->sha256);
+	}
+#endif
+}
+
+/*
+ * Hash a regular file in a single update from a mapping of it. Returns 0 if the
+ * file cannot be mapped, in which case nothing has been hashed.
+ */
+static int sha_update_mapped(sha_ctx_t *ctx, FILE *inFile)
+{
+#ifndef _WIN32
+	struct stat st;
+	void *data;
+
+	if ((fstat(fileno(inFile), &st) != 0) || !S_ISREG(st.st_mode) ||
+	    (st.st_size <= 0) || ((uintmax_t)st.st_size > SIZE_MAX)) {
+		return 0;
+	}
 
+	data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fileno(inFile),
+		    0);
+	if (data == MAP_FAILED) {
+		return 0;
+	}
+
+	posix_madvise(data, st.st_size, POSIX_MADV_SEQUENTIAL);
+	sha_update(ctx, data, st.st_size);
+	munmap(data, st.st_size);
+
+	return 1;
+#else
+	return 0;
 #endif
 }
 
+static int sha_update_read(sha_ctx_t *ctx, FILE *inFile)
+{
+	unsigned char *data;
+	size_t bytes;
+
+	data = malloc(BUFFER_SIZE);
+	if (data == NULL) {
+		ERROR("%s(): Failed to allocate memory\n", __func__);
+		return 0;
+	}
+
+	while ((bytes = fread(data, 1, BUFFER_SIZE, inFile)) != 0) {
+		sha_update(ctx, data, bytes);
+	}
+
+	free(data);
+	return 1;
+}
+
+int sha_file(int md_alg, const char *filename, unsigned char *md)
+{
+	FILE *inFile;
+	sha_ctx_t ctx;
+
+	if ((filename == NULL) || (md == NULL)) {
+		ERROR("%s(): NULL argument\n", __func__);
+		return 0;
+	}
+
+	inFile = fopen(filename, "rb");
+	if (inFile == NULL) {
+		ERROR("Cannot read %s\n", filename);
+		return 0;
+	}
+
+	if (!sha_init(&ctx, md_alg)) {
+		fclose(inFile);
+		return 0;
+	}
+
+	/* Fall back to reading the files that cannot be mapped, e.g. pipes */
+	if (!sha_update_mapped(&ctx, inFile) &&
+	    !sha_update_read(&ctx, inFile)) {
+		sha_final(&ctx, md);
+		fclose(inFile);
+		return 0;
+	}
+
+	sha_final(&ctx, md);
+	fclose(inFile);
+	return 1;
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Check tf_crc32() against zlib's crc32(). Every buffer alignment within a
+ * double word is tried with every length up to a few hundred bytes, so that
+ * the unaligned head, the word loop and each tail length are all covered,
+ * and a CRC is also accumulated over several calls.
+ *
+ * With -b, the throughput of both is measured instead over a range of buffer
+ * sizes.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <common/tf_crc32.h>
+#include <host_test.h>
+#include <zlib.h>
+
+#define MAX_LEN		300U
+#define MAX_OFF		16U
+
+/* Each buffer size is hashed until BENCH_BYTES have been processed */
+#define BENCH_MIN_SIZE	64U
+#define BENCH_MAX_SIZE	(1U << 20)
+#define BENCH_BYTES	(64U << 20)
+
+static unsigned char buf[MAX_OFF + MAX_LEN] __attribute__((aligned(64)));
+static unsigned char bench_buf[BENCH_MAX_SIZE] __attribute__((aligned(64)));
+
+/* Keeps the compiler from dropping CRCs whose result is otherwise unused */
+static volatile uint32_t bench_sink;
+
+static double bench_tf_crc32(size_t size)
+{
+	size_t done;
+	uint32_t crc = 0U;
+	double start = host_test_time();
+
+	for (done = 0U; done < BENCH_BYTES; done += size) {
+		crc = tf_crc32(crc, bench_buf, size);
+	}
+	bench_sink = crc;
+
+	return (double)BENCH_BYTES / (host_test_time() - start) / 1e6;
+}
+
+static double bench_zlib_crc32(size_t size)
+{
+	size_t done;
+	unsigned long crc = 0UL;
+	double start = host_test_time();
+
+	for (done = 0U; done < BENCH_BYTES; done += size) {
+		crc = crc32(crc, bench_buf, size);
+	}
+	bench_sink = (uint32_t)crc;
+
+	return (double)BENCH_BYTES / (host_test_time() - start) / 1e6;
+}
+
+static void bench(void)
+{
+	size_t size;
+
+	for (size = 0U; size < sizeof(bench_buf); size++) {
+		bench_buf[size] = (unsigned char)((size * 197U) >> 1);
+	}
+
+	printf("%10s %16s %16s\n", "size", "tf_crc32 MB/s", "zlib MB/s");
+	for (size = BENCH_MIN_SIZE; size <= BENCH_MAX_SIZE; size *= 4U) {
+		printf("%10zu %16.0f %16.0f\n", size, bench_tf_crc32(size),
+		       bench_zlib_crc32(size));
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned int off, failures = 0U;
+	size_t len, split;
+	uint32_t crc, ref;
+
+	if ((argc == 2) && (strcmp(argv[1], "-b") == 0)) {
+		bench();
+		return 0;
+	}
+
+	for (len = 0U; len < sizeof(buf); len++) {
+		buf[len] = (unsigned char)((len * 197U) >> 1);
+	}
+
+	for (off = 0U; off < MAX_OFF; off++) {
+		for (len = 0U; len <= MAX_LEN; len++) {
+			ref = (uint32_t)crc32(0UL, &buf[off], len);
+
+			crc = tf_crc32(0U, &buf[off], len);
+			if (crc != ref) {
+				printf("FAIL: off=%u len=%zu: 0x%08x != 0x%08x\n",
+				       off, len, crc, ref);
+				failures++;
+			}
+
+			/* The same CRC, accumulated over two calls */
+			split = len / 3U;
+			crc = tf_crc32(0U, &buf[off], split);
+			crc = tf_crc32(crc, &buf[off + split], len - split);
+			if (crc != ref) {
+				printf("FAIL: off=%u len=%zu split=%zu: 0x%08x != 0x%08x\n",
+				       off, len, split, crc, ref);
+				failures++;
+			}
+		}
+	}
+
+	if (failures != 0U) {
+		printf("%u checks failed\n", failures);
+		return 1;
+	}
+
+	printf("All checks passed\n");
+
+	return 0;
+}
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Compare the decoders available to image_decompress_init() on real images:
+ * each compressed file given is decoded with the firmware decoder matching its
+ * format, checked against the original image, and its compression ratio and
+ * decode speed are reported.
+ */
+
+#include <errno.h>
+#include <getopt.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <tf_unlz4.h>
+#include <zlib.h>
+
+#define GZIP_MAGIC	0x8b1fU
+#define LZ4_MAGIC	0x184D2204U
+
+/* Size of the pieces that streaming decoders are fed */
+#define STREAM_CHUNK_SIZE	4096U
+
+typedef int (decoder_t)(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
+			size_t out_len);
+
+static void *zcalloc(void *opaque, unsigned int items, unsigned int size)
+{
+	return calloc(items, size);
+}
+
+static void zfree(void *opaque, void *ptr)
+{
+	free(ptr);
+}
+
+/* Same as gunzip() in the firmware, with the host allocator */
+static int decode_gzip(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
+		       size_t out_len)
+{
+	z_stream stream;
+	int zret;
+
+	memset(&stream, 0, sizeof(stream));
+	stream.next_in = (Bytef *)*in_buf;
+	stream.avail_in = in_len;
+	stream.next_out = (Bytef *)*out_buf;
+	stream.avail_out = out_len;
+	stream.zalloc = zcalloc;
+	stream.zfree = zfree;
+
+	if (inflateInit(&stream) != Z_OK)
+		return -ENOMEM;
+
+	zret = inflate(&stream, Z_NO_FLUSH);
+
+	*in_buf = (uintptr_t)stream.next_in;
+	*out_buf = (uintptr_t)stream.next_out;
+
+	inflateEnd(&stream);
+
+	return (zret == Z_STREAM_END) ? 0 : -EIO;
+}
+
+static int decode_lz4(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
+		      size_t out_len)
+{
+	return unlz4(in_buf, in_len, out_buf, out_len, 0, 0);
+}
+
+/* Largest LZ4 block and its checksum */
+static uint8_t lz4_work[(4U << 20) + 4U];
+
+/* unlz4_stream fed in pieces, as image_decompress_init_stream() does */
+static int decode_lz4_stream(uintptr_t *in_buf, size_t in_len,
+			     uintptr_t *out_buf, size_t out_len)
+{
+	size_t off, len;
+	int ret;
+
+	ret = unlz4_stream.init(*out_buf, out_len, (uintptr_t)lz4_work,
+				sizeof(lz4_work));
+	for (off = 0U; (ret == 0) && (off < in_len); off += len) {
+		len = in_len - off;
+		if (len > STREAM_CHUNK_SIZE)
+			len = STREAM_CHUNK_SIZE;
+		ret = unlz4_stream.feed(*in_buf + off, len);
+	}
+	if (ret == 0)
+		ret = unlz4_stream.end(out_buf);
+
+	*in_buf += in_len;
+
+	return ret;
+}
+
+struct decoder {
+	const char *name;
+	decoder_t *decode;
+};
+
+static const struct decoder gzip_decoders[] = {
+	{ "gzip", decode_gzip },
+	{ NULL, NULL },
+};
+
+static const struct decoder lz4_decoders[] = {
+	{ "lz4", decode_lz4 },
+	{ "lz4-strm", decode_lz4_stream },
+	{ NULL, NULL },
+};
+
+static void *read_file(const char *filename, size_t *size)
+{
+	FILE *fp;
+	void *buf;
+	long len;
+
+	fp = fopen(filename, "rb");
+	if (fp == NULL) {
+		perror(filename);
+		exit(1);
+	}
+
+	if ((fseek(fp, 0, SEEK_END) != 0) || ((len = ftell(fp)) < 0) ||
+	    (fseek(fp, 0, SEEK_SET) != 0)) {
+		perror(filename);
+		exit(1);
+	}
+
+	buf = malloc(len + 1);
+	if (buf == NULL) {
+		fprintf(stderr, "Out of memory\n");
+		exit(1);
+	}
+
+	if (fread(buf, 1, len, fp) != (size_t)len) {
+		fprintf(stderr, "Failed to read %s\n", filename);
+		exit(1);
+	}
+
+	fclose(fp);
+	*size = len;
+
+	return buf;
+}
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void usage(void)
+{
+	printf("decompress_bench [-n iterations] IMAGE COMPRESSED_IMAGE...\n");
+	printf("\n");
+	printf("Supported formats: gzip, lz4 (frame format)\n");
+	exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned int iterations = 10U, i;
+	size_t image_len, comp_len;
+	uint8_t *image, *comp, *out;
+	uintptr_t in_buf, out_buf;
+	const char *image_name;
+	const struct decoder *decoders, *d;
+	double start, elapsed;
+	int opt, ret = 0;
+
+	while ((opt = getopt(argc, argv, "n:")) != -1) {
+		switch (opt) {
+		case 'n':
+			iterations = strtoul(optarg, NULL, 0);
+			if (iterations == 0U)
+				usage();
+			break;
+		default:
+			usage();
+		}
+	}
+
+	if ((argc - optind) < 2)
+		usage();
+
+	image_name = argv[optind];
+	image = read_file(image_name, &image_len);
+	out = malloc(image_len + 1);
+	if (out == NULL) {
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+
+	printf("%-32s %8s %10s %8s %10s\n", "file", "decoder", "size",
+	       "ratio", "MB/s");
+
+	for (optind++; optind < argc; optind++) {
+		comp = read_file(argv[optind], &comp_len);
+
+		if ((comp_len >= 4U) &&
+		    ((comp[0] | (comp[1] << 8)) == GZIP_MAGIC)) {
+			decoders = gzip_decoders;
+		} else if ((comp_len >= 4U) &&
+			   ((comp[0] | (comp[1] << 8) | (comp[2] << 16) |
+			     ((uint32_t)comp[3] << 24)) == LZ4_MAGIC)) {
+			decoders = lz4_decoders;
+		} else {
+			fprintf(stderr, "%s: unknown format\n", argv[optind]);
+			free(comp);
+			ret = 1;
+			continue;
+		}
+
+		for (d = decoders; d->name != NULL; d++) {
+			start = now();
+			for (i = 0U; i < iterations; i++) {
+				in_buf = (uintptr_t)comp;
+				out_buf = (uintptr_t)out;
+				/* A spare byte detects too long an output */
+				if (d->decode(&in_buf, comp_len, &out_buf,
+					      image_len + 1) != 0) {
+					break;
+				}
+			}
+			elapsed = now() - start;
+
+			if ((i != iterations) ||
+			    ((out_buf - (uintptr_t)out) != image_len) ||
+			    (memcmp(out, image, image_len) != 0)) {
+				fprintf(stderr, "%s: %s does not decode to %s\n",
+					argv[optind], d->name, image_name);
+				ret = 1;
+				continue;
+			}
+
+			printf("%-32s %8s %10zu %7.2f%% %10.1f\n",
+			       argv[optind], d->name, comp_len,
+			       100.0 * comp_len / image_len,
+			       (double)image_len * iterations / elapsed / 1e6);
+		}
+
+		free(comp);
+	}
+
+	free(out);
+	free(image);
+
+	return ret;
+}
@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2019, Linaro Limited. All rights reserved.
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
  * Author: Sumit Garg <sumit.garg@linaro.org>
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -8,11 +9,17 @@
 #include <firmware_encrypted.h>
 #include <openssl/evp.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "debug.h"
 #include "encrypt.h"
 
-#define BUFFER_SIZE		256
+/*
+ * Size of the blocks the input is encrypted in. Only one block of plaintext and
+ * one of ciphertext are held in memory at a time, whatever the size of the
+ * input.
+ */
+#define BUFFER_SIZE		(1024 * 1024)
 #define IV_SIZE			12
 #define IV_STRING_SIZE		24
 #define TAG_SIZE		16
@@ -26,9 +33,10 @@ static int gcm_encrypt(unsigned short fw_enc_status, char *key_string,
 	FILE *ip_file;
 	FILE *op_file;
 	EVP_CIPHER_CTX *ctx;
-	unsigned char data[BUFFER_SIZE], enc_data[BUFFER_SIZE];
+	unsigned char *data, *enc_data;
 	unsigned char key[KEY_SIZE], iv[IV_SIZE], tag[TAG_SIZE];
-	int bytes, enc_len = 0, i, j, ret = 0;
+	size_t bytes;
+	int enc_len = 0, i, j, ret = 0;
 	struct fw_enc_hdr header;
 
 	memset(&header, 0, sizeof(struct fw_enc_hdr));
@@ -76,11 +84,19 @@ static int gcm_encrypt(unsigned short fw_enc_status, char *key_string,
 		goto out_file;
 	}
 
+	data = malloc(BUFFER_SIZE);
+	enc_data = malloc(BUFFER_SIZE);
+	if ((data == NULL) || (enc_data == NULL)) {
+		ERROR("Failed to allocate memory\n");
+		ret = -1;
+		goto out_buf;
+	}
+
 	ctx = EVP_CIPHER_CTX_new();
 	if (ctx == NULL) {
 		ERROR("EVP_CIPHER_CTX_new failed\n");
 		ret = -1;
-		goto out_file;
+		goto out_buf;
 	}
 
 	ret = EVP_EncryptInit_ex(ctx, EVP_aes_256_gcm(), NULL, NULL, NULL);
@@ -93,6 +109,7 @@ static int gcm_encrypt(unsigned short fw_enc_status, char *key_string,
 	ret = EVP_EncryptInit_ex(ctx, NULL, NULL, key, iv);
 	if (ret != 1) {
 		ERROR("EVP_EncryptInit_ex failed\n");
+		ret = -1;
 		goto out;
 	}
 
@@ -104,7 +121,17 @@ static int gcm_encrypt(unsigned short fw_enc_status, char *key_string,
 			goto out;
 		}
 
-		fwrite(enc_data, 1, enc_len, op_file);
+		if (fwrite(enc_data, 1, enc_len, op_file) != (size_t)enc_len) {
+			ERROR("Cannot write %s\n", op_name);
+			ret = -1;
+			goto out;
+		}
+	}
+
+	if (ferror(ip_file)) {
+		ERROR("Cannot read %s\n", ip_name);
+		ret = -1;
+		goto out;
 	}
 
 	ret = EVP_EncryptFinal_ex(ctx, enc_data, &enc_len);
@@ -135,14 +162,27 @@ static int gcm_encrypt(unsigned short fw_enc_status, char *key_string,
 		goto out;
 	}
 
-	fwrite(&header, 1, sizeof(struct fw_enc_hdr), op_file);
+	if (fwrite(&header, 1, sizeof(struct fw_enc_hdr), op_file) !=
+	    sizeof(struct fw_enc_hdr)) {
+		ERROR("Cannot write %s\n", op_name);
+		ret = -1;
+		goto out;
+	}
 
 out:
 	EVP_CIPHER_CTX_free(ctx);
 
+out_buf:
+	free(enc_data);
+	free(data);
+
 out_file:
 	fclose(ip_file);
-	fclose(op_file);
+	/* Buffered data may only fail to be written out on close */
+	if ((fclose(op_file) != 0) && (ret >= 0)) {
+		ERROR("Cannot write %s\n", op_name);
+		ret = -1;
+	}
 
 	/*
 	 * EVP_* APIs returns 1 as success but enctool considers
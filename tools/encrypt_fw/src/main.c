@@ -1,16 +1,21 @@
 /*
  * Copyright (c) 2019, Linaro Limited. All rights reserved.
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
  * Author: Sumit Garg <sumit.garg@linaro.org>
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+/* For realpath() */
+#define _XOPEN_SOURCE	700
+
 #include <assert.h>
 #include <ctype.h>
 #include <getopt.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 #include <stdbool.h>
 
 #include <openssl/conf.h>
@@ -19,9 +24,11 @@
 #include "debug.h"
 #include "encrypt.h"
 #include "firmware_encrypted.h"
+#include "tool_jobs.h"
 
 #define NUM_ELEM(x)			((sizeof(x)) / (sizeof(x[0])))
 #define HELP_OPT_MAX_LEN		128
+#define MANIFEST_LINE_MAX_LEN		4096
 
 /* Global options */
 
@@ -98,6 +105,219 @@ static void parse_fw_enc_status_flag(const char *arg,
 	*fw_enc_status = flag & FW_ENC_STATUS_FLAG_MASK;
 }
 
+/* One image of a manifest */
+typedef struct batch_entry {
+	char *in_fn;
+	char *out_fn;
+	char *nonce;
+	/* Canonical paths of in_fn and out_fn, to find files used twice */
+	char *in_path;
+	char *out_path;
+	int ret;
+} batch_entry_t;
+
+/* Batch of images encrypted with the same key by encrypt_batch() */
+typedef struct batch {
+	batch_entry_t *entries;
+	int num;
+	unsigned short fw_enc_status;
+	int key_alg;
+	char *key;
+} batch_t;
+
+static char *strdup_or_exit(const char *str)
+{
+	char *dup = malloc(strlen(str) + 1);
+
+	if (dup == NULL) {
+		ERROR("Failed to allocate memory\n");
+		exit(1);
+	}
+
+	return strcpy(dup, str);
+}
+
+/*
+ * Return the canonical absolute path of 'fn', resolving symbolic links, so
+ * that different names of the same file compare equal. An output file doesn't
+ * have to exist yet, only its directory does.
+ */
+static char *canonical_path(const char *fn)
+{
+	char *path, *dir_path, *dir, *base, *copy;
+
+	path = realpath(fn, NULL);
+	if (path != NULL) {
+		return path;
+	}
+
+	copy = strdup_or_exit(fn);
+	base = strrchr(copy, '/');
+	if (base == NULL) {
+		dir = ".";
+		base = copy;
+	} else if (base == copy) {
+		dir = "/";
+		base++;
+	} else {
+		*base++ = '\0';
+		dir = copy;
+	}
+
+	dir_path = realpath(dir, NULL);
+	if ((dir_path == NULL) || (*base == '\0')) {
+		ERROR("Cannot resolve %s\n", fn);
+		exit(1);
+	}
+
+	path = malloc(strlen(dir_path) + strlen(base) + 2);
+	if (path == NULL) {
+		ERROR("Failed to allocate memory\n");
+		exit(1);
+	}
+	sprintf(path, "%s/%s", strcmp(dir_path, "/") == 0 ? "" : dir_path,
+		base);
+
+	free(dir_path);
+	free(copy);
+
+	return path;
+}
+
+/*
+ * Read the manifest 'fn', made of lines of the form
+ *
+ *	<input filename> <output filename> <nonce>
+ *
+ * Empty lines and lines starting with '#' are ignored. As the images are all
+ * encrypted with the same key, their nonces must all differ. As they are
+ * encrypted concurrently, no file may be written by one image and read or
+ * written by another, which is checked on the canonical paths so that e.g.
+ * "./a" and "a" are the same file. The output is written while the input is
+ * read, so an image can't be encrypted in place either.
+ */
+static void parse_manifest(const char *fn, batch_t *batch)
+{
+	char line[MANIFEST_LINE_MAX_LEN];
+	char *field[3], *extra, *p;
+	batch_entry_t *entries;
+	FILE *file;
+	int i, j, line_num = 0;
+
+	file = fopen(fn, "r");
+	if (file == NULL) {
+		ERROR("Cannot read %s\n", fn);
+		exit(1);
+	}
+
+	while (fgets(line, sizeof(line), file) != NULL) {
+		line_num++;
+
+		if (strchr(line, '\n') == NULL && !feof(file)) {
+			ERROR("%s:%d: line too long\n", fn, line_num);
+			exit(1);
+		}
+
+		p = line;
+		while (isspace((unsigned char)*p)) {
+			p++;
+		}
+		if ((*p == '\0') || (*p == '#')) {
+			continue;
+		}
+
+		for (i = 0; i < 3; i++) {
+			field[i] = strtok((i == 0) ? p : NULL, " \t\r\n");
+		}
+		extra = strtok(NULL, " \t\r\n");
+		if ((field[2] == NULL) || (extra != NULL)) {
+			ERROR("%s:%d: expected '<in> <out> <nonce>'\n", fn,
+			      line_num);
+			exit(1);
+		}
+
+		entries = realloc(batch->entries,
+				  (batch->num + 1) * sizeof(*entries));
+		if (entries == NULL) {
+			ERROR("Failed to allocate memory\n");
+			exit(1);
+		}
+		batch->entries = entries;
+
+		entries[batch->num].in_fn = strdup_or_exit(field[0]);
+		entries[batch->num].out_fn = strdup_or_exit(field[1]);
+		entries[batch->num].nonce = strdup_or_exit(field[2]);
+		entries[batch->num].in_path = canonical_path(field[0]);
+		entries[batch->num].out_path = canonical_path(field[1]);
+		entries[batch->num].ret = -1;
+		batch->num++;
+	}
+
+	fclose(file);
+
+	if (batch->num == 0) {
+		ERROR("No image in %s\n", fn);
+		exit(1);
+	}
+
+	for (i = 0; i < batch->num; i++) {
+		for (j = 0; j < batch->num; j++) {
+			if (strcmp(batch->entries[i].out_path,
+				   batch->entries[j].in_path) == 0) {
+				ERROR("%s is both an output and an input\n",
+				      batch->entries[i].out_fn);
+				exit(1);
+			}
+			if (j >= i) {
+				continue;
+			}
+			if (strcasecmp(batch->entries[i].nonce,
+				       batch->entries[j].nonce) == 0) {
+				ERROR("Nonce of %s already used for %s\n",
+				      batch->entries[i].in_fn,
+				      batch->entries[j].in_fn);
+				exit(1);
+			}
+			if (strcmp(batch->entries[i].out_path,
+				   batch->entries[j].out_path) == 0) {
+				ERROR("%s is the output of several images\n",
+				      batch->entries[i].out_fn);
+				exit(1);
+			}
+		}
+	}
+}
+
+static void encrypt_entry(void *arg, int i)
+{
+	batch_t *batch = arg;
+	batch_entry_t *entry = &batch->entries[i];
+
+	entry->ret = encrypt_file(batch->fw_enc_status, batch->key_alg,
+				  batch->key, entry->nonce, entry->in_fn,
+				  entry->out_fn);
+}
+
+/*
+ * Encrypt the images of the batch with up to 'num_jobs' threads. Returns 0 if
+ * all of them were encrypted.
+ */
+static int encrypt_batch(batch_t *batch, int num_jobs)
+{
+	int i, ret = 0;
+
+	tool_jobs_run(num_jobs, encrypt_entry, batch, batch->num);
+
+	for (i = 0; i < batch->num; i++) {
+		if (batch->entries[i].ret != 0) {
+			ERROR("Cannot encrypt %s\n", batch->entries[i].in_fn);
+			ret = -1;
+		}
+	}
+
+	return ret;
+}
+
 /* Common command line options */
 static const cmd_opt_t common_cmd_opt[] = {
 	{
@@ -128,6 +348,17 @@ static const cmd_opt_t common_cmd_opt[] = {
 		{ "out", required_argument, NULL, 'o' },
 		"Encrypted output filename."
 	},
+	{
+		{ "manifest", required_argument, NULL, 'm' },
+		"File listing images to encrypt with the key, one " \
+		"'<in> <out> <nonce>' per line, instead of --in, --out " \
+		"and --nonce."
+	},
+	{
+		{ "jobs", required_argument, NULL, 'j' },
+		"Number of images of the manifest encrypted in parallel " \
+		"(default: number of online CPUs)."
+	},
 };
 
 int main(int argc, char *argv[])
@@ -139,7 +370,10 @@ int main(int argc, char *argv[])
 	char *nonce = NULL;
 	char *in_fn = NULL;
 	char *out_fn = NULL;
+	char *manifest_fn = NULL;
+	int num_jobs = -1;
 	unsigned short fw_enc_status = 0;
+	batch_t batch = { 0 };
 
 	NOTICE("Firmware Encryption Tool: %s\n", build_msg);
 
@@ -156,7 +390,7 @@ int main(int argc, char *argv[])
 
 	while (1) {
 		/* getopt_long stores the option index here. */
-		c = getopt_long(argc, argv, "a:f:hi:k:n:o:", cmd_opt, &opt_idx);
+		c = getopt_long(argc, argv, "a:f:hi:j:k:m:n:o:", cmd_opt, &opt_idx);
 
 		/* Detect the end of the options. */
 		if (c == -1) {
@@ -174,9 +408,19 @@ int main(int argc, char *argv[])
 		case 'f':
 			parse_fw_enc_status_flag(optarg, &fw_enc_status);
 			break;
+		case 'j':
+			num_jobs = tool_jobs_parse(optarg);
+			if (num_jobs <= 0) {
+				ERROR("Invalid number of jobs '%s'\n", optarg);
+				exit(1);
+			}
+			break;
 		case 'k':
 			key = optarg;
 			break;
+		case 'm':
+			manifest_fn = optarg;
+			break;
 		case 'i':
 			in_fn = optarg;
 			break;
@@ -201,6 +445,29 @@ int main(int argc, char *argv[])
 		exit(1);
 	}
 
+	if (manifest_fn) {
+		if (nonce || in_fn || out_fn) {
+			ERROR("Nonce and filenames come from the manifest\n");
+			exit(1);
+		}
+
+		/* Use one thread per CPU by default */
+		if (num_jobs == -1) {
+			num_jobs = tool_jobs_default();
+		}
+
+		parse_manifest(manifest_fn, &batch);
+		batch.fw_enc_status = fw_enc_status;
+		batch.key_alg = key_alg;
+		batch.key = key;
+
+		ret = encrypt_batch(&batch, num_jobs);
+
+		CRYPTO_cleanup_all_ex_data();
+
+		return ret;
+	}
+
 	if (!nonce) {
 		ERROR("Nonce must not be NULL\n");
 		exit(1);
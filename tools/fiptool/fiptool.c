@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2023, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2026, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -18,6 +18,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #include "fiptool.h"
 #include "tbbr_config.h"
@@ -25,6 +26,24 @@
 #define OPT_TOC_ENTRY 0
 #define OPT_PLAT_TOC_FLAGS 1
 #define OPT_ALIGN 2
+#define OPT_JOBS 3
+
+#if defined(__GLIBC__) && \
+    ((__GLIBC__ > 2) || ((__GLIBC__ == 2) && (__GLIBC_MINOR__ >= 27)))
+#define HAVE_COPY_FILE_RANGE 1
+#endif
+
+#ifndef _MSC_VER
+typedef int out_file_t;
+#else
+typedef FILE *out_file_t;
+#endif
+
+typedef struct unpack_job {
+	image_t		*image;
+	char		file[PATH_MAX];
+	uint64_t	time_ns;
+} unpack_job_t;
 
 static int info_cmd(int argc, char *argv[]);
 static void info_usage(int);
@@ -56,6 +75,7 @@ static image_desc_t *image_desc_head;
 static size_t nr_image_descs;
 static const uuid_t uuid_null;
 static int verbose;
+static int stats;
 
 static void vlog(int prio, const char *msg, va_list ap)
 {
@@ -131,10 +151,268 @@ static void *xzalloc(size_t size, const char *msg)
 	return memset(xmalloc(size, msg), 0, size);
 }
 
-static void xfwrite(void *buf, size_t size, FILE *fp, const char *filename)
+static uint64_t time_now_ns(void)
+{
+#ifndef _MSC_VER
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#else
+	return (uint64_t)clock() * (1000000000ULL / CLOCKS_PER_SEC);
+#endif
+}
+
+static void print_stats(const char *name, uint64_t size, uint64_t time_ns)
+{
+	printf("%s: %llu bytes in %.3f ms\n", name,
+	    (unsigned long long)size, (double)time_ns / 1e6);
+}
+
+#ifndef _MSC_VER
+static void xpread(int fd, void *buf, size_t size, uint64_t offset,
+    const char *filename)
+{
+	while (size > 0) {
+		ssize_t n = pread(fd, buf, size, offset);
+
+		if (n == -1 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			log_errx("Failed to read %s", filename);
+		buf = (char *)buf + n;
+		size -= n;
+		offset += n;
+	}
+}
+
+static void xpwrite(int fd, const void *buf, size_t size, uint64_t offset,
+    const char *filename)
+{
+	while (size > 0) {
+		ssize_t n = pwrite(fd, buf, size, offset);
+
+		if (n == -1 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			log_errx("Failed to write %s", filename);
+		buf = (const char *)buf + n;
+		size -= n;
+		offset += n;
+	}
+}
+#endif
+
+/*
+ * Map a whole input file into memory, falling back to reading it where it
+ * cannot be mapped. The caller owns the single initial reference.
+ */
+static file_map_t *map_file(const char *filename)
 {
-	if (fwrite(buf, 1, size, fp) != size)
+	file_map_t *map;
+#ifdef _MSC_VER
+	FILE *fp;
+#endif
+
+	map = xzalloc(sizeof(*map), "failed to allocate memory for file map");
+	map->refcount = 1;
+
+#ifndef _MSC_VER
+	map->fd = open(filename, O_RDONLY);
+	if (map->fd == -1)
+		log_err("open %s", filename);
+
+	if (fstat(map->fd, &map->st) == -1)
+		log_err("fstat %s", filename);
+
+	map->size = map->st.st_size;
+
+#ifdef BLKGETSIZE64
+	if ((map->st.st_mode & S_IFBLK) != 0)
+		if (ioctl(map->fd, BLKGETSIZE64, &map->size) == -1)
+			log_err("ioctl %s", filename);
+#endif
+
+	if (map->size == 0)
+		return map;
+
+	map->addr = mmap(NULL, map->size, PROT_READ, MAP_PRIVATE, map->fd, 0);
+	if (map->addr != MAP_FAILED) {
+		map->mapped = 1;
+		return map;
+	}
+
+	map->addr = xmalloc(map->size, "failed to load file into memory");
+	xpread(map->fd, map->addr, map->size, 0, filename);
+#else
+	map->fd = -1;
+	fp = fopen(filename, "rb");
+	if (fp == NULL)
+		log_err("fopen %s", filename);
+
+	if (fstat(fileno(fp), &map->st) == -1)
+		log_err("fstat %s", filename);
+
+	map->size = map->st.st_size;
+	map->addr = xmalloc(map->size, "failed to load file into memory");
+	if (fread(map->addr, 1, map->size, fp) != map->size)
+		log_errx("Failed to read %s", filename);
+	fclose(fp);
+#endif
+	return map;
+}
+
+static void put_file_map(file_map_t *map)
+{
+	assert(map->refcount > 0);
+
+	if (--map->refcount != 0)
+		return;
+#ifndef _MSC_VER
+	if (map->mapped)
+		munmap(map->addr, map->size);
+	else
+		free(map->addr);
+	close(map->fd);
+#else
+	free(map->addr);
+#endif
+	free(map);
+}
+
+static void free_image(image_t *image)
+{
+	if (image->map != NULL)
+		put_file_map(image->map);
+	else
+		free(image->buffer);
+	free(image);
+}
+
+/* Give an image a private copy of its contents and drop its file map. */
+static void detach_image(image_t *image)
+{
+	void *buffer;
+
+	if (image->map == NULL)
+		return;
+
+	buffer = xmalloc(image->toc_e.size, "failed to allocate image buffer");
+	memcpy(buffer, image->buffer, image->toc_e.size);
+	put_file_map(image->map);
+	image->map = NULL;
+	image->buffer = buffer;
+}
+
+/*
+ * Open an output file that will hold 'size' bytes. Regular files are
+ * pre-sized so that the writes that follow may be done in any order.
+ */
+static out_file_t open_output(const char *filename, uint64_t size)
+{
+#ifndef _MSC_VER
+	struct BLD_PLAT_STAT st;
+	int fd;
+
+	fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+	if (fd == -1)
+		log_err("open %s", filename);
+
+	if (fstat(fd, &st) == -1)
+		log_err("fstat %s", filename);
+
+	if (S_ISREG(st.st_mode) && ftruncate(fd, size) == -1)
+		log_err("ftruncate %s", filename);
+
+	return fd;
+#else
+	FILE *fp;
+
+	fp = fopen(filename, "wb");
+	if (fp == NULL)
+		log_err("fopen %s", filename);
+
+	return fp;
+#endif
+}
+
+static void write_output(out_file_t out, const void *buf, size_t size,
+    uint64_t offset, const char *filename)
+{
+#ifndef _MSC_VER
+	xpwrite(out, buf, size, offset, filename);
+#else
+	if (fseek(out, offset, SEEK_SET))
+		log_errx("Failed to set file position");
+	if (fwrite(buf, 1, size, out) != size)
 		log_errx("Failed to write %s", filename);
+#endif
+}
+
+/*
+ * Write the contents of an image at 'offset'. Where possible the data is
+ * copied from the file it was mapped from without going through user space.
+ */
+static void write_image(out_file_t out, const image_t *image, uint64_t offset,
+    const char *filename)
+{
+	const char *buf = image->buffer;
+	size_t left = image->toc_e.size;
+
+#ifdef HAVE_COPY_FILE_RANGE
+	if (image->map != NULL) {
+		loff_t src = buf - (const char *)image->map->addr;
+		loff_t dst = offset;
+
+		while (left > 0) {
+			ssize_t n = copy_file_range(image->map->fd, &src,
+			    out, &dst, left, 0);
+
+			if (n <= 0)
+				break;
+			buf += n;
+			offset += n;
+			left -= n;
+		}
+	}
+#endif
+	write_output(out, buf, left, offset, filename);
+}
+
+static void close_output(out_file_t out, const char *filename)
+{
+#ifndef _MSC_VER
+	if (close(out) == -1)
+		log_err("close %s", filename);
+#else
+	if (fclose(out) != 0)
+		log_errx("Failed to write %s", filename);
+#endif
+}
+
+/*
+ * Images mapped from the file about to be written must be copied out of it
+ * first, as opening it for output truncates it.
+ */
+static void detach_images_from(const char *filename)
+{
+#ifndef _MSC_VER
+	struct BLD_PLAT_STAT st;
+	image_desc_t *desc;
+
+	if (stat(filename, &st) == -1)
+		return;
+
+	for (desc = image_desc_head; desc != NULL; desc = desc->next) {
+		image_t *image = desc->image;
+
+		if (image == NULL || image->map == NULL)
+			continue;
+		if (image->map->st.st_dev == st.st_dev &&
+		    image->map->st.st_ino == st.st_ino)
+			detach_image(image);
+	}
+#endif
 }
 
 static image_desc_t *new_image_desc(const uuid_t *uuid,
@@ -172,10 +450,8 @@ static void free_image_desc(image_desc_t *desc)
 	free(desc->name);
 	free(desc->cmdline_name);
 	free(desc->action_arg);
-	if (desc->image) {
-		free(desc->image->buffer);
-		free(desc->image);
-	}
+	if (desc->image)
+		free_image(desc->image);
 	free(desc);
 }
 
@@ -295,34 +571,18 @@ static void uuid_from_str(uuid_t *u, const char *s)
 
 static int parse_fip(const char *filename, fip_toc_header_t *toc_header_out)
 {
-	struct BLD_PLAT_STAT st;
-	FILE *fp;
+	file_map_t *map;
 	char *buf, *bufend;
 	fip_toc_header_t *toc_header;
 	fip_toc_entry_t *toc_entry;
 	int terminated = 0;
 	size_t st_size;
 
-	fp = fopen(filename, "rb");
-	if (fp == NULL)
-		log_err("fopen %s", filename);
-
-	if (fstat(fileno(fp), &st) == -1)
-		log_err("fstat %s", filename);
-
-	st_size = st.st_size;
-
-#ifdef BLKGETSIZE64
-	if ((st.st_mode & S_IFBLK) != 0)
-		if (ioctl(fileno(fp), BLKGETSIZE64, &st_size) == -1)
-			log_err("ioctl %s", filename);
-#endif
-
-	buf = xmalloc(st_size, "failed to load file into memory");
-	if (fread(buf, 1, st_size, fp) != st_size)
-		log_errx("Failed to read %s", filename);
+	/* Images point into the FIP rather than getting their own copy. */
+	map = map_file(filename);
+	buf = map->addr;
+	st_size = map->size;
 	bufend = buf + st_size;
-	fclose(fp);
 
 	if (st_size < sizeof(fip_toc_header_t))
 		log_errx("FIP %s is truncated", filename);
@@ -355,9 +615,7 @@ static int parse_fip(const char *filename, fip_toc_header_t *toc_header_out)
 		image = xzalloc(sizeof(*image),
 		    "failed to allocate memory for image");
 		image->toc_e = *toc_entry;
-		image->buffer = xmalloc(toc_entry->size,
-		    "failed to allocate image buffer, is FIP file corrupted?");
-		/* Overflow checks before memory copy. */
+		/* Overflow checks before referencing the image contents. */
 		if (toc_entry->size > (uint64_t)-1 - toc_entry->offset_address)
 			log_errx("FIP %s is corrupted: entry size exceeds 64 bit address space",
 				filename);
@@ -365,8 +623,9 @@ static int parse_fip(const char *filename, fip_toc_header_t *toc_header_out)
 			log_errx("FIP %s is corrupted: entry size exceeds FIP file size",
 				filename);
 
-		memcpy(image->buffer, buf + toc_entry->offset_address,
-		    toc_entry->size);
+		image->buffer = buf + toc_entry->offset_address;
+		image->map = map;
+		map->refcount++;
 
 		/* If this is an unknown image, create a descriptor for it. */
 		desc = lookup_image_desc_from_uuid(&toc_entry->uuid);
@@ -392,47 +651,110 @@ static int parse_fip(const char *filename, fip_toc_header_t *toc_header_out)
 	if (terminated == 0)
 		log_errx("FIP %s does not have a ToC terminator entry",
 		    filename);
-	free(buf);
+	put_file_map(map);
 	return 0;
 }
 
 static image_t *read_image_from_file(const uuid_t *uuid, const char *filename)
 {
-	struct BLD_PLAT_STAT st;
 	image_t *image;
-	FILE *fp;
+	file_map_t *map;
 
 	assert(uuid != NULL);
 	assert(filename != NULL);
 
-	fp = fopen(filename, "rb");
-	if (fp == NULL)
-		log_err("fopen %s", filename);
-
-	if (fstat(fileno(fp), &st) == -1)
-		log_errx("fstat %s", filename);
+	map = map_file(filename);
 
 	image = xzalloc(sizeof(*image), "failed to allocate memory for image");
 	image->toc_e.uuid = *uuid;
-	image->buffer = xmalloc(st.st_size, "failed to allocate image buffer");
-	if (fread(image->buffer, 1, st.st_size, fp) != st.st_size)
-		log_errx("Failed to read %s", filename);
-	image->toc_e.size = st.st_size;
-
-	fclose(fp);
+	image->buffer = map->addr;
+	image->toc_e.size = map->size;
+	image->map = map;
 	return image;
 }
 
-static int write_image_to_file(const image_t *image, const char *filename)
+static void unpack_image(unpack_job_t *job)
 {
-	FILE *fp;
+	uint64_t start_ns = time_now_ns();
+	out_file_t out;
 
-	fp = fopen(filename, "wb");
-	if (fp == NULL)
-		log_err("fopen");
-	xfwrite(image->buffer, image->toc_e.size, fp, filename);
-	fclose(fp);
-	return 0;
+	out = open_output(job->file, job->image->toc_e.size);
+	write_image(out, job->image, 0, job->file);
+	close_output(out, job->file);
+	job->time_ns = time_now_ns() - start_ns;
+}
+
+#ifndef _MSC_VER
+typedef struct unpack_queue {
+	unpack_job_t	*jobs;
+	size_t		nr_jobs;
+	size_t		next;
+	pthread_mutex_t	lock;
+} unpack_queue_t;
+
+static void *unpack_worker(void *arg)
+{
+	unpack_queue_t *queue = arg;
+
+	while (1) {
+		size_t i;
+
+		pthread_mutex_lock(&queue->lock);
+		i = queue->next++;
+		pthread_mutex_unlock(&queue->lock);
+
+		if (i >= queue->nr_jobs)
+			break;
+		unpack_image(&queue->jobs[i]);
+	}
+	return NULL;
+}
+#endif
+
+/* Write out the unpacked images, spread over up to 'nr_threads' threads. */
+static void unpack_images(unpack_job_t *jobs, size_t nr_jobs,
+    unsigned long nr_threads)
+{
+	size_t i;
+
+#ifndef _MSC_VER
+	if (nr_threads > nr_jobs)
+		nr_threads = nr_jobs;
+
+	if (nr_threads > 1) {
+		unpack_queue_t queue = {
+			.jobs = jobs,
+			.nr_jobs = nr_jobs,
+			.next = 0,
+			.lock = PTHREAD_MUTEX_INITIALIZER
+		};
+		pthread_t *threads;
+
+		threads = xmalloc(nr_threads * sizeof(*threads),
+		    "failed to allocate memory for unpack threads");
+		for (i = 0; i < nr_threads; i++)
+			if (pthread_create(&threads[i], NULL, unpack_worker,
+			    &queue) != 0)
+				log_errx("Failed to create unpack thread");
+		for (i = 0; i < nr_threads; i++)
+			pthread_join(threads[i], NULL);
+		free(threads);
+		return;
+	}
+#endif
+	for (i = 0; i < nr_jobs; i++)
+		unpack_image(&jobs[i]);
+}
+
+static unsigned long get_default_jobs(void)
+{
+#ifndef _MSC_VER
+	long n = sysconf(_SC_NPROCESSORS_ONLN);
+
+	if (n > 0)
+		return n;
+#endif
+	return 1;
 }
 
 static struct option *add_opt(struct option *opts, size_t *nr_opts,
@@ -529,12 +851,13 @@ static void info_usage(int exit_status)
 
 static int pack_images(const char *filename, uint64_t toc_flags, unsigned long align)
 {
-	FILE *fp;
+	out_file_t out;
 	image_desc_t *desc;
 	fip_toc_header_t *toc_header;
 	fip_toc_entry_t *toc_entry;
 	char *buf;
 	uint64_t entry_offset, buf_size, payload_size = 0, pad_size;
+	uint64_t start_ns, image_start_ns;
 	size_t nr_images = 0;
 
 	for (desc = image_desc_head; desc != NULL; desc = desc->next)
@@ -576,15 +899,15 @@ static int pack_images(const char *filename, uint64_t toc_flags, unsigned long a
 	memset(toc_entry, 0, sizeof(*toc_entry));
 	toc_entry->offset_address = (entry_offset + align - 1) & ~(align - 1);
 
-	/* Generate the FIP file. */
-	fp = fopen(filename, "wb");
-	if (fp == NULL)
-		log_err("fopen %s", filename);
+	/* Generate the FIP file, sized up front to its final length. */
+	start_ns = time_now_ns();
+	detach_images_from(filename);
+	out = open_output(filename, toc_entry->offset_address);
 
 	if (verbose)
 		log_dbgx("Metadata size: %zu bytes", buf_size);
 
-	xfwrite(buf, buf_size, fp, filename);
+	write_output(out, buf, buf_size, 0, filename);
 
 	if (verbose)
 		log_dbgx("Payload size: %zu bytes", payload_size);
@@ -592,23 +915,31 @@ static int pack_images(const char *filename, uint64_t toc_flags, unsigned long a
 	for (desc = image_desc_head; desc != NULL; desc = desc->next) {
 		image_t *image = desc->image;
 
-		if (image == NULL)
+		if (image == NULL || (image->toc_e.size == 0ULL))
 			continue;
-		if (fseek(fp, image->toc_e.offset_address, SEEK_SET))
-			log_errx("Failed to set file position");
 
-		xfwrite(image->buffer, image->toc_e.size, fp, filename);
+		image_start_ns = time_now_ns();
+		write_image(out, image, image->toc_e.offset_address, filename);
+		if (stats)
+			print_stats(desc->name, image->toc_e.size,
+			    time_now_ns() - image_start_ns);
 	}
 
-	if (fseek(fp, entry_offset, SEEK_SET))
-		log_errx("Failed to set file position");
-
 	pad_size = toc_entry->offset_address - entry_offset;
-	while (pad_size--)
-		fputc(0x0, fp);
+	if (pad_size != 0) {
+		char *pad = xzalloc(pad_size,
+		    "failed to allocate memory for padding");
+
+		write_output(out, pad, pad_size, entry_offset, filename);
+		free(pad);
+	}
+
+	close_output(out, filename);
+	if (stats)
+		print_stats(filename, toc_entry->offset_address,
+		    time_now_ns() - start_ns);
 
 	free(buf);
-	fclose(fp);
 	return 0;
 }
 
@@ -638,7 +969,7 @@ static void update_fip(void)
 				    desc->cmdline_name,
 				    desc->action_arg);
 			}
-			free(desc->image);
+			free_image(desc->image);
 			desc->image = image;
 		} else {
 			if (verbose)
@@ -667,6 +998,19 @@ static int is_power_of_2(unsigned long x)
 	return x && !(x & (x - 1));
 }
 
+static unsigned long get_jobs(char *arg)
+{
+	char *endptr;
+	unsigned long jobs;
+
+	errno = 0;
+	jobs = strtoul(arg, &endptr, 0);
+	if (*endptr != '\0' || jobs == 0 || errno != 0)
+		log_errx("Invalid number of jobs: %s", arg);
+
+	return jobs;
+}
+
 static unsigned long get_image_align(char *arg)
 {
 	char *endptr;
@@ -922,6 +1266,10 @@ static int unpack_cmd(int argc, char *argv[])
 	size_t nr_opts = 0;
 	char outdir[PATH_MAX] = { 0 };
 	image_desc_t *desc;
+	unpack_job_t *jobs;
+	size_t i, nr_jobs = 0;
+	uint64_t start_ns, total_size = 0;
+	unsigned long nr_threads = get_default_jobs();
 	int fflag = 0;
 	int unpack_all = 1;
 
@@ -931,6 +1279,7 @@ static int unpack_cmd(int argc, char *argv[])
 	opts = fill_common_opts(opts, &nr_opts, required_argument);
 	opts = add_opt(opts, &nr_opts, "blob", required_argument, 'b');
 	opts = add_opt(opts, &nr_opts, "force", no_argument, 'f');
+	opts = add_opt(opts, &nr_opts, "jobs", required_argument, OPT_JOBS);
 	opts = add_opt(opts, &nr_opts, "out", required_argument, 'o');
 	opts = add_opt(opts, &nr_opts, NULL, 0, 0);
 
@@ -976,6 +1325,9 @@ static int unpack_cmd(int argc, char *argv[])
 		case 'f':
 			fflag = 1;
 			break;
+		case OPT_JOBS:
+			nr_threads = get_jobs(optarg);
+			break;
 		case 'o':
 			snprintf(outdir, sizeof(outdir), "%s", optarg);
 			break;
@@ -996,7 +1348,10 @@ static int unpack_cmd(int argc, char *argv[])
 		if (chdir(outdir) == -1)
 			log_err("chdir %s", outdir);
 
-	/* Unpack all specified images. */
+	jobs = xzalloc(nr_image_descs * sizeof(*jobs),
+	    "failed to allocate memory for unpack jobs");
+
+	/* Collect all specified images. */
 	for (desc = image_desc_head; desc != NULL; desc = desc->next) {
 		char file[PATH_MAX];
 		image_t *image = desc->image;
@@ -1022,13 +1377,30 @@ static int unpack_cmd(int argc, char *argv[])
 		if (access(file, F_OK) != 0 || fflag) {
 			if (verbose)
 				log_dbgx("Unpacking %s", file);
-			write_image_to_file(image, file);
+			jobs[nr_jobs].image = image;
+			snprintf(jobs[nr_jobs].file, sizeof(jobs[nr_jobs].file),
+			    "%s", file);
+			nr_jobs++;
 		} else {
 			log_warnx("File %s already exists, use --force to overwrite it",
 			    file);
 		}
 	}
 
+	/* Unpack them, in parallel where possible. */
+	start_ns = time_now_ns();
+	unpack_images(jobs, nr_jobs, nr_threads);
+
+	if (stats) {
+		for (i = 0; i < nr_jobs; i++) {
+			print_stats(jobs[i].file, jobs[i].image->toc_e.size,
+			    jobs[i].time_ns);
+			total_size += jobs[i].image->toc_e.size;
+		}
+		print_stats(argv[0], total_size, time_now_ns() - start_ns);
+	}
+
+	free(jobs);
 	return 0;
 }
 
@@ -1041,6 +1413,7 @@ static void unpack_usage(int exit_status)
 	printf("Options:\n");
 	printf("  --blob uuid=...,file=...\tUnpack an image with the given UUID to file.\n");
 	printf("  --force\t\t\tIf the output file already exists, use --force to overwrite it.\n");
+	printf("  --jobs <value>\t\tNumber of images to unpack in parallel (default: number of CPUs).\n");
 	printf("  --out path\t\t\tSet the output directory path.\n");
 	printf("\n");
 	printf("Specific images are unpacked with the following options:\n");
@@ -1150,7 +1523,7 @@ static int remove_cmd(int argc, char *argv[])
 			if (verbose)
 				log_dbgx("Removing %s",
 				    desc->cmdline_name);
-			free(desc->image);
+			free_image(desc->image);
 			desc->image = NULL;
 		} else {
 			log_warnx("%s does not exist in %s",
@@ -1224,8 +1597,9 @@ static int help_cmd(int argc, char *argv[])
 
 static void usage(void)
 {
-	printf("usage: fiptool [--verbose] <command> [<args>]\n");
+	printf("usage: fiptool [--stats] [--verbose] <command> [<args>]\n");
 	printf("Global options supported:\n");
+	printf("  --stats\tReport the size and write time of each image.\n");
 	printf("  --verbose\tEnable verbose output for all commands.\n");
 	printf("\n");
 	printf("Commands supported:\n");
@@ -1246,6 +1620,7 @@ int main(int argc, char *argv[])
 	while (1) {
 		int c, opt_index = 0;
 		static struct option opts[] = {
+			{ "stats", no_argument, NULL, 's' },
 			{ "verbose", no_argument, NULL, 'v' },
 			{ NULL, no_argument, NULL, 0 }
 		};
@@ -1259,6 +1634,9 @@ int main(int argc, char *argv[])
 			break;
 
 		switch (c) {
+		case 's':
+			stats = 1;
+			break;
 		case 'v':
 			verbose = 1;
 			break;
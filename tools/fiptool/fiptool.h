@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2017, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2026, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -7,6 +7,8 @@
 #ifndef FIPTOOL_H
 #define FIPTOOL_H
 
+#include <sys/stat.h>
+
 #include <stddef.h>
 #include <stdint.h>
 
@@ -40,9 +42,23 @@ typedef struct image_desc {
 	struct image_desc *next;
 } image_desc_t;
 
+/*
+ * Contents of an input file, either mapped or read into memory. Images may
+ * point into it, each holding a reference.
+ */
+typedef struct file_map {
+	void               *addr;
+	size_t              size;
+	int                 fd;
+	int                 mapped;
+	unsigned int        refcount;
+	struct BLD_PLAT_STAT st;
+} file_map_t;
+
 typedef struct image {
 	struct fip_toc_entry toc_e;
 	void                *buffer;
+	file_map_t          *map;	/* NULL if buffer is heap allocated */
 } image_t;
 
 typedef struct cmd {
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Exercise concurrent granule transitions in the GPT library. The library is
+ * built against the TF-A headers with host stand-ins for the system
+ * registers, barriers and spinlocks, and driven from several host threads.
+ *
+ * A 4GB PPS is mapped as NS with 4KB granules, so that it is made of four L0
+ * regions and 16 granules share each L1 descriptor. The granules of windows
+ * around each L0 region boundary are handed out to the threads in turn.
+ * Neighbouring granules therefore belong to different threads but share L1
+ * descriptors, and the two halves of each window take different locks. Each
+ * thread then repeatedly delegates and undelegates its own granules, checking
+ * that:
+ * - a delegation of an NS granule succeeds, and a second one is rejected,
+ * - an undelegation from the owning state succeeds, and a second one is
+ *   rejected,
+ * and, once all threads are done, that every granule is back in the NS state.
+ * An update of a shared L1 descriptor lost to a race shows up as an
+ * unexpected result, and a locking problem as a timeout.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <lib/gpt_rme/gpt_rme.h>
+
+/* Caller security states, as in lib/smccc.h which needs the TF-A libc */
+#define SMC_FROM_SECURE	0U
+#define SMC_FROM_REALM	0x21U
+
+#define GRANULE_SIZE	4096UL
+#define L0_REGION_SIZE	(1UL << 30)
+#define PPS_SIZE	(4UL << 30)
+/* One L1 table per L0 region, 4 bits per 4KB granule */
+#define L1_TABLE_SIZE	((L0_REGION_SIZE / GRANULE_SIZE) / 2UL)
+
+#define THREADS		8U
+/* Granules in the window around each L0 region boundary */
+#define WINDOW_GRANULES	64U
+#define WINDOWS		3U
+#define ITERATIONS	2000U
+#define TIMEOUT_S	120U
+
+static uint64_t l0_table[GRANULE_SIZE / 8UL]
+	__attribute__((aligned(GRANULE_SIZE)));
+static uint64_t l1_tables[4UL * L1_TABLE_SIZE / 8UL]
+	__attribute__((aligned(L1_TABLE_SIZE)));
+
+static unsigned int failures;
+
+/* Host replacement for the firmware assertion handler */
+void __assert(const char *file, unsigned int line)
+{
+	printf("ASSERT: %s:%u\n", file, line);
+	exit(1);
+	__builtin_unreachable();
+}
+
+/* Host replacement for the xlat library granule size check */
+bool xlat_arch_is_granule_size_supported(size_t size)
+{
+	return size == GRANULE_SIZE;
+}
+
+#define CHECK(cond, ...)						\
+	do {								\
+		if (!(cond)) {						\
+			if (__atomic_fetch_add(&failures, 1U,		\
+					       __ATOMIC_RELAXED) < 20U) { \
+				printf("FAIL: " __VA_ARGS__);		\
+			}						\
+		}							\
+	} while (0)
+
+/* Base address of a granule, in a window centred on an L0 region boundary */
+static uint64_t granule_base(unsigned int window, unsigned int granule)
+{
+	uint64_t start = ((window + 1UL) * L0_REGION_SIZE) -
+			 ((WINDOW_GRANULES / 2UL) * GRANULE_SIZE);
+
+	return start + (granule * GRANULE_SIZE);
+}
+
+static void *worker(void *arg)
+{
+	unsigned int id = (unsigned int)(uintptr_t)arg;
+	unsigned int iter, window, granule, state;
+	size_t size = GRANULE_SIZE;
+	uint64_t base;
+	int ret;
+
+	for (iter = 0U; iter < ITERATIONS; iter++) {
+		/* Alternate between the Realm and Secure PAS */
+		state = ((iter + id) % 2U) ? SMC_FROM_SECURE : SMC_FROM_REALM;
+
+		for (window = 0U; window < WINDOWS; window++) {
+			for (granule = id; granule < WINDOW_GRANULES;
+			     granule += THREADS) {
+				base = granule_base(window, granule);
+
+				ret = gpt_delegate_pas(base, size, state);
+				CHECK(ret == 0, "delegate 0x%llx: %d\n",
+				      (unsigned long long)base, ret);
+				ret = gpt_delegate_pas(base, size, state);
+				CHECK(ret == -EPERM,
+				      "delegate 0x%llx twice: %d\n",
+				      (unsigned long long)base, ret);
+				ret = gpt_undelegate_pas(base, size, state);
+				CHECK(ret == 0, "undelegate 0x%llx: %d\n",
+				      (unsigned long long)base, ret);
+				ret = gpt_undelegate_pas(base, size, state);
+				CHECK(ret == -EPERM,
+				      "undelegate 0x%llx twice: %d\n",
+				      (unsigned long long)base, ret);
+			}
+		}
+	}
+
+	return NULL;
+}
+
+int main(void)
+{
+	pas_region_t pas = GPT_MAP_REGION_GRANULE(0UL, PPS_SIZE, GPT_GPI_NS);
+	pthread_t threads[THREADS];
+	unsigned int i, window, granule;
+	uint64_t base;
+	int ret;
+
+	ret = gpt_init_l0_tables(GPCCR_PPS_4GB, (uintptr_t)l0_table,
+				 sizeof(l0_table));
+	if (ret == 0) {
+		ret = gpt_init_pas_l1_tables(GPCCR_PGS_4K, (uintptr_t)l1_tables,
+					     sizeof(l1_tables), &pas, 1U);
+	}
+	if (ret != 0) {
+		printf("GPT initialisation failed: %d\n", ret);
+		return 1;
+	}
+
+	/* Ranges of granules are not supported */
+	ret = gpt_delegate_pas(granule_base(0U, 0U), 2UL * GRANULE_SIZE,
+			       SMC_FROM_REALM);
+	CHECK(ret == -EINVAL, "delegate of two granules: %d\n", ret);
+
+	/* A locking problem would hang the test */
+	alarm(TIMEOUT_S);
+
+	for (i = 0U; i < THREADS; i++) {
+		if (pthread_create(&threads[i], NULL, worker,
+				   (void *)(uintptr_t)i) != 0) {
+			printf("Cannot create thread %u\n", i);
+			return 1;
+		}
+	}
+	for (i = 0U; i < THREADS; i++) {
+		pthread_join(threads[i], NULL);
+	}
+
+	/* Every granule must be back in NS, so it can be delegated again */
+	for (window = 0U; window < WINDOWS; window++) {
+		for (granule = 0U; granule < WINDOW_GRANULES; granule++) {
+			base = granule_base(window, granule);
+			ret = gpt_delegate_pas(base, GRANULE_SIZE,
+					       SMC_FROM_REALM);
+			CHECK(ret == 0, "granule 0x%llx left in use: %d\n",
+			      (unsigned long long)base, ret);
+		}
+	}
+
+	if (failures != 0U) {
+		printf("%u checks failed\n", failures);
+		return 1;
+	}
+
+	printf("%u threads, %u iterations: all checks passed\n", THREADS,
+	       ITERATIONS);
+
+	return 0;
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef ARCH_HELPERS_H
+#define ARCH_HELPERS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <arch.h>
+
+/*
+ * Host replacement for the system register accessors, barriers and cache
+ * maintenance used by the GPT library. The GPT registers are kept in memory
+ * and caches are reported as enabled. The barriers only stop the compiler
+ * from reordering, the spinlocks order the table updates between threads.
+ */
+typedef uint64_t u_register_t;
+
+static u_register_t gpccr_el3, gptbr_el3;
+
+static inline u_register_t read_sctlr_el3(void)
+{
+	return SCTLR_C_BIT;
+}
+
+static inline u_register_t read_gpccr_el3(void)
+{
+	return gpccr_el3;
+}
+
+static inline void write_gpccr_el3(u_register_t v)
+{
+	gpccr_el3 = v;
+}
+
+static inline u_register_t read_gptbr_el3(void)
+{
+	return gptbr_el3;
+}
+
+static inline void write_gptbr_el3(u_register_t v)
+{
+	gptbr_el3 = v;
+}
+
+static inline void host_barrier(void)
+{
+	__asm__ volatile("" : : : "memory");
+}
+
+#define isb()		host_barrier()
+#define dsb()		host_barrier()
+#define dsbsy()		host_barrier()
+#define dsbishst()	host_barrier()
+#define dsbosh()	host_barrier()
+#define dsboshst()	host_barrier()
+
+static inline void tlbipaallos(void)
+{
+}
+
+static inline void tlbirpalos(u_register_t v)
+{
+	(void)v;
+}
+
+static inline void flush_dcache_range(uintptr_t addr, size_t size)
+{
+	(void)addr;
+	(void)size;
+}
+
+static inline void flush_dcache_to_popa_range(uintptr_t addr, size_t size)
+{
+	(void)addr;
+	(void)size;
+}
+
+#endif /* ARCH_HELPERS_H */
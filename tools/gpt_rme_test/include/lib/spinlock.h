@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SPINLOCK_H
+#define SPINLOCK_H
+
+#include <stdint.h>
+
+/* Host replacement for the firmware spinlocks, using compiler atomics */
+typedef struct spinlock {
+	volatile uint32_t lock;
+} spinlock_t;
+
+static inline void spin_lock(spinlock_t *lock)
+{
+	while (__atomic_exchange_n(&lock->lock, 1U, __ATOMIC_ACQUIRE) != 0U) {
+		while (__atomic_load_n(&lock->lock, __ATOMIC_RELAXED) != 0U) {
+		}
+	}
+}
+
+static inline void spin_unlock(spinlock_t *lock)
+{
+	__atomic_store_n(&lock->lock, 0U, __ATOMIC_RELEASE);
+}
+
+#endif /* SPINLOCK_H */
@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef XLAT_TABLES_V2_H
+#define XLAT_TABLES_V2_H
+
+/*
+ * Host replacement, the GPT library only needs the definitions. The granule
+ * size check is provided by the test.
+ */
+#include <lib/xlat_tables/xlat_tables_defs.h>
+
+#endif /* XLAT_TABLES_V2_H */
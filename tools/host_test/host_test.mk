@@ -0,0 +1,56 @@
+#
+# Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+# Common part of the Makefiles of the host tests and benchmarks in tools/,
+# which build firmware sources for the host. A Makefile sets HOST_TEST_NAME
+# and OBJECTS before including this file. It then sets HOSTCCFLAGS,
+# INCLUDE_PATHS and HOSTLDFLAGS, and adds rules for any object that is built
+# differently. HOST_TEST_INCLUDE_PATHS holds the host stand-ins for firmware
+# headers that the tools share, such as common/debug.h, and host_test.h. The
+# helpers it declares are linked by adding e.g. host_test_time.o to OBJECTS.
+
+HOST_TEST_DIR := $(patsubst %/,%,$(dir $(lastword ${MAKEFILE_LIST})))
+MAKE_HELPERS_DIRECTORY := ${HOST_TEST_DIR}/../../make_helpers/
+include ${MAKE_HELPERS_DIRECTORY}build_macros.mk
+include ${MAKE_HELPERS_DIRECTORY}build_env.mk
+
+PROJECT := ${HOST_TEST_NAME}${BIN_EXT}
+V ?= 0
+
+HOSTCC ?= gcc
+
+HOST_TEST_INCLUDE_PATHS := -I${HOST_TEST_DIR}/include
+
+ifeq (${V},0)
+  Q := @
+else
+  Q :=
+endif
+
+.PHONY: all clean distclean
+
+all: ${PROJECT}
+
+${PROJECT}: ${OBJECTS} Makefile
+	@echo "  HOSTLD  $@"
+	${Q}${HOSTCC} ${HOSTLDFLAGS} ${OBJECTS} -o $@
+	@${ECHO_BLANK_LINE}
+	@echo "Built $@ successfully"
+	@${ECHO_BLANK_LINE}
+
+%.o: %.c Makefile
+	@echo "  HOSTCC  $<"
+	${Q}${HOSTCC} -c ${HOSTCCFLAGS} ${INCLUDE_PATHS} $< -o $@
+
+# The helpers are built with the host headers, whatever the tool uses
+host_test_%.o: ${HOST_TEST_DIR}/host_test_%.c Makefile
+	@echo "  HOSTCC  $<"
+	${Q}${HOSTCC} -c -Wall -std=gnu99 -O2 ${HOST_TEST_INCLUDE_PATHS} $< -o $@
+
+clean:
+	$(call SHELL_DELETE_ALL, ${PROJECT} ${OBJECTS})
+
+distclean: clean
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef DEBUG_H
+#define DEBUG_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <lib/utils_def.h>
+
+/*
+ * Host replacement for the firmware logging macros and panic(), shared by the
+ * host tests and benchmarks in tools/. Only printf() and abort() are used, so
+ * that it works with both the host and the TF-A libc headers.
+ */
+#define LOG_LEVEL_NONE			U(0)
+#define LOG_LEVEL_ERROR			U(10)
+#define LOG_LEVEL_NOTICE		U(20)
+#define LOG_LEVEL_WARNING		U(30)
+#define LOG_LEVEL_INFO			U(40)
+#define LOG_LEVEL_VERBOSE		U(50)
+
+/*
+ * Messages up to HOST_TEST_LOG_LEVEL are printed, which defaults to warnings.
+ * Tests where warnings are expected, e.g. on allocation failures, lower it.
+ */
+#ifndef HOST_TEST_LOG_LEVEL
+#define HOST_TEST_LOG_LEVEL		LOG_LEVEL_WARNING
+#endif
+
+#define host_log(level, prefix, ...)				\
+	do {							\
+		if (HOST_TEST_LOG_LEVEL >= (level)) {		\
+			printf(prefix __VA_ARGS__);		\
+		}						\
+	} while (0)
+
+#define ERROR(...)	host_log(LOG_LEVEL_ERROR, "ERROR:   ", __VA_ARGS__)
+#define WARN(...)	host_log(LOG_LEVEL_WARNING, "WARNING: ", __VA_ARGS__)
+#define NOTICE(...)	host_log(LOG_LEVEL_NOTICE, "NOTICE:  ", __VA_ARGS__)
+#define INFO(...)	host_log(LOG_LEVEL_INFO, "INFO:    ", __VA_ARGS__)
+#define VERBOSE(...)	host_log(LOG_LEVEL_VERBOSE, "VERBOSE: ", __VA_ARGS__)
+
+#define panic()		abort()
+
+#endif /* DEBUG_H */
@@ -0,0 +1,13 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+/* Monotonic time in seconds, for the benchmarks. Link host_test_time.o. */
+double host_test_time(void);
+
+#endif /* HOST_TEST_H */
@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Check the firmware versions of memcpy, memmove, memcmp and strlen against
+ * the host C library. The C versions from lib/libc are checked on any host,
+ * and the AArch64 assembly versions from lib/libc/aarch64 as well on AArch64.
+ * Every combination of source and destination alignment is tried with
+ * lengths covering the byte head, the 64-byte loop and every tail length,
+ * and memmove is exercised with overlaps in both directions.
+ *
+ * With -b, the throughput of each version is measured instead over a range
+ * of sizes, with the host C library for reference.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <host_test.h>
+
+/* Largest length tried exhaustively, a few 64-byte blocks plus any tail */
+#define MAX_LEN		300U
+/* Offsets tried for each pointer, one full double word of misalignment */
+#define MAX_OFF		16U
+/* Bytes around each buffer that must be left untouched */
+#define GUARD		32U
+#define BUF_SIZE	(GUARD + MAX_OFF + MAX_LEN + GUARD)
+/* memmove moves up to MAX_LEN / 2 bytes by up to MAX_LEN / 2 either way */
+#define MOVE_BUF_SIZE	(GUARD + MAX_LEN + MAX_OFF + MAX_LEN + GUARD)
+
+#define GUARD_BYTE	0xa5U
+
+/* Sizes measured by the benchmark, each until BENCH_BYTES are processed */
+#define BENCH_MIN_SIZE	16U
+#define BENCH_MAX_SIZE	(64U << 10)
+#define BENCH_BYTES	(64U << 20)
+
+/* The C versions, renamed with a tfc_ prefix */
+void *tfc_memcpy(void *dst, const void *src, size_t len);
+void *tfc_memmove(void *dst, const void *src, size_t len);
+int tfc_memcmp(const void *s1, const void *s2, size_t len);
+size_t tfc_strlen(const char *s);
+
+#ifdef __aarch64__
+/* The assembly versions, renamed with a tf_ prefix */
+void *tf_memcpy(void *dst, const void *src, size_t len);
+void *tf_memmove(void *dst, const void *src, size_t len);
+int tf_memcmp(const void *s1, const void *s2, size_t len);
+size_t tf_strlen(const char *s);
+#endif
+
+struct libc_impl {
+	const char *name;
+	void *(*memcpy_fn)(void *dst, const void *src, size_t len);
+	void *(*memmove_fn)(void *dst, const void *src, size_t len);
+	int (*memcmp_fn)(const void *s1, const void *s2, size_t len);
+	size_t (*strlen_fn)(const char *s);
+};
+
+/* The versions that are tested, followed by the host one for reference */
+static const struct libc_impl impls[] = {
+	{ "C", tfc_memcpy, tfc_memmove, tfc_memcmp, tfc_strlen },
+#ifdef __aarch64__
+	{ "asm", tf_memcpy, tf_memmove, tf_memcmp, tf_strlen },
+#endif
+	{ "host", memcpy, memmove, memcmp, strlen },
+};
+
+#define NUM_TESTED	((sizeof(impls) / sizeof(impls[0])) - 1U)
+#define NUM_IMPLS	(sizeof(impls) / sizeof(impls[0]))
+
+static unsigned int failures;
+
+/* Reports a failure of the version that the caller's impl points to */
+#define CHECK(cond, ...)						\
+	do {								\
+		if (!(cond)) {						\
+			if (failures++ < 20U) {				\
+				printf("FAIL: %s ", impl->name);	\
+				printf(__VA_ARGS__);			\
+			}						\
+		}							\
+	} while (0)
+
+static uint8_t src_buf[BUF_SIZE] __attribute__((aligned(64)));
+static uint8_t dst_buf[BUF_SIZE] __attribute__((aligned(64)));
+static uint8_t ref_buf[BUF_SIZE] __attribute__((aligned(64)));
+static uint8_t move_buf[MOVE_BUF_SIZE] __attribute__((aligned(64)));
+static uint8_t move_ref_buf[MOVE_BUF_SIZE] __attribute__((aligned(64)));
+static uint8_t bench_src[BENCH_MAX_SIZE + 64U] __attribute__((aligned(64)));
+static uint8_t bench_dst[BENCH_MAX_SIZE + 64U] __attribute__((aligned(64)));
+
+/* Keeps the compiler from dropping calls whose result is otherwise unused */
+static volatile size_t bench_sink;
+
+static void fill(uint8_t *buf, size_t len, unsigned int seed)
+{
+	size_t i;
+
+	for (i = 0U; i < len; i++) {
+		/* Avoid zero bytes so that buffers can also be strings */
+		buf[i] = (uint8_t)(((i + seed) * 131U) % 255U) + 1U;
+	}
+}
+
+static void test_memcpy(const struct libc_impl *impl)
+{
+	unsigned int d, s;
+	size_t len;
+	void *ret;
+
+	fill(src_buf, BUF_SIZE, 1U);
+
+	for (d = 0U; d < MAX_OFF; d++) {
+		for (s = 0U; s < MAX_OFF; s++) {
+			for (len = 0U; len <= MAX_LEN; len++) {
+				memset(dst_buf, GUARD_BYTE, BUF_SIZE);
+				memset(ref_buf, GUARD_BYTE, BUF_SIZE);
+				memcpy(&ref_buf[GUARD + d], &src_buf[GUARD + s],
+				       len);
+
+				ret = impl->memcpy_fn(&dst_buf[GUARD + d],
+						&src_buf[GUARD + s], len);
+
+				CHECK(ret == &dst_buf[GUARD + d],
+				      "memcpy d=%u s=%u len=%zu: bad return\n",
+				      d, s, len);
+				CHECK(memcmp(dst_buf, ref_buf, BUF_SIZE) == 0,
+				      "memcpy d=%u s=%u len=%zu: bad copy\n",
+				      d, s, len);
+			}
+		}
+	}
+}
+
+static void test_memmove(const struct libc_impl *impl)
+{
+	unsigned int s;
+	int shift;
+	size_t len;
+	uint8_t *src, *dst;
+	void *ret;
+
+	for (s = 0U; s < MAX_OFF; s++) {
+		for (shift = -(int)MAX_LEN / 2; shift <= (int)MAX_LEN / 2;
+		     shift++) {
+			for (len = 0U; len <= MAX_LEN / 2U; len++) {
+				fill(move_buf, MOVE_BUF_SIZE, 7U);
+				fill(move_ref_buf, MOVE_BUF_SIZE, 7U);
+
+				src = &move_buf[GUARD + (MAX_LEN / 2U) + s];
+				dst = src + shift;
+				memmove(&move_ref_buf[dst - move_buf],
+					&move_ref_buf[src - move_buf], len);
+
+				ret = impl->memmove_fn(dst, src, len);
+
+				CHECK(ret == dst,
+				      "memmove s=%u shift=%d len=%zu: bad return\n",
+				      s, shift, len);
+				CHECK(memcmp(move_buf, move_ref_buf,
+					     MOVE_BUF_SIZE) == 0,
+				      "memmove s=%u shift=%d len=%zu: bad copy\n",
+				      s, shift, len);
+			}
+		}
+	}
+}
+
+static int sign(int v)
+{
+	return (v > 0) - (v < 0);
+}
+
+static void test_memcmp(const struct libc_impl *impl)
+{
+	unsigned int a, b;
+	size_t len, pos;
+	uint8_t *s1, *s2;
+	int ret;
+
+	for (a = 0U; a < MAX_OFF; a++) {
+		for (b = 0U; b < MAX_OFF; b++) {
+			s1 = &src_buf[GUARD + a];
+			s2 = &dst_buf[GUARD + b];
+
+			for (len = 0U; len <= MAX_LEN; len++) {
+				fill(s1, len, 3U);
+				fill(s2, len, 3U);
+				/* Bytes past the end must not be looked at */
+				s1[len] = 0x01U;
+				s2[len] = 0xffU;
+
+				ret = impl->memcmp_fn(s1, s2, len);
+				CHECK(ret == 0,
+				      "memcmp a=%u b=%u len=%zu: %d for equal\n",
+				      a, b, len, ret);
+
+				for (pos = 0U; pos < len;
+				     pos += (len < 80U) ? 1U : 13U) {
+					/* Bytes are compared as unsigned */
+					s1[pos] = 0x80U;
+					s2[pos] = 0x01U;
+					ret = impl->memcmp_fn(s1, s2, len);
+					CHECK(sign(ret) == 1,
+					      "memcmp a=%u b=%u len=%zu pos=%zu: %d\n",
+					      a, b, len, pos, ret);
+					ret = impl->memcmp_fn(s2, s1, len);
+					CHECK(sign(ret) == -1,
+					      "memcmp a=%u b=%u len=%zu pos=%zu: %d\n",
+					      a, b, len, pos, ret);
+					s1[pos] = s2[pos];
+				}
+			}
+		}
+	}
+}
+
+static void test_strlen(const struct libc_impl *impl)
+{
+	unsigned int a;
+	size_t len, ret, page_size;
+	char *page, *str;
+
+	for (a = 0U; a < MAX_OFF; a++) {
+		for (len = 0U; len <= MAX_LEN; len++) {
+			str = (char *)&src_buf[GUARD + a];
+			fill((uint8_t *)str, len, 5U);
+			str[len] = '\0';
+
+			ret = impl->strlen_fn(str);
+			CHECK(ret == len, "strlen a=%u len=%zu: got %zu\n",
+			      a, len, ret);
+		}
+	}
+
+	/* Strings ending right before an inaccessible page */
+	page_size = (size_t)sysconf(_SC_PAGESIZE);
+	page = mmap(NULL, 2U * page_size, PROT_READ | PROT_WRITE,
+		    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if ((page == MAP_FAILED) ||
+	    (mprotect(page + page_size, page_size, PROT_NONE) != 0)) {
+		perror("mmap");
+		exit(1);
+	}
+
+	for (len = 0U; len <= MAX_LEN; len++) {
+		str = page + page_size - len - 1U;
+		fill((uint8_t *)str, len, 9U);
+		str[len] = '\0';
+
+		ret = impl->strlen_fn(str);
+		CHECK(ret == len, "strlen at page end len=%zu: got %zu\n",
+		      len, ret);
+	}
+
+	munmap(page, 2U * page_size);
+}
+
+static __attribute__((noinline)) double
+bench_memcpy(const struct libc_impl *impl, size_t size)
+{
+	size_t done;
+	double start = host_test_time();
+
+	for (done = 0U; done < BENCH_BYTES; done += size) {
+		impl->memcpy_fn(bench_dst, bench_src, size);
+	}
+
+	return (double)BENCH_BYTES / (host_test_time() - start) / 1e6;
+}
+
+static __attribute__((noinline)) double
+bench_memmove(const struct libc_impl *impl, size_t size)
+{
+	size_t done;
+	double start = host_test_time();
+
+	/* Overlapping, with the destination above the source */
+	for (done = 0U; done < BENCH_BYTES; done += size) {
+		impl->memmove_fn(&bench_src[8], bench_src, size);
+	}
+
+	return (double)BENCH_BYTES / (host_test_time() - start) / 1e6;
+}
+
+static __attribute__((noinline)) double
+bench_memcmp(const struct libc_impl *impl, size_t size)
+{
+	size_t done;
+	int ret = 0;
+	double start = host_test_time();
+
+	/* Equal buffers, so that every byte is compared */
+	for (done = 0U; done < BENCH_BYTES; done += size) {
+		ret |= impl->memcmp_fn(bench_dst, bench_src, size);
+	}
+	bench_sink = (size_t)ret;
+
+	return (double)BENCH_BYTES / (host_test_time() - start) / 1e6;
+}
+
+static __attribute__((noinline)) double
+bench_strlen(const struct libc_impl *impl, size_t size)
+{
+	size_t done, ret = 0U;
+	double start = host_test_time();
+
+	for (done = 0U; done < BENCH_BYTES; done += size) {
+		ret += impl->strlen_fn((const char *)bench_src);
+	}
+	bench_sink = ret;
+
+	return (double)BENCH_BYTES / (host_test_time() - start) / 1e6;
+}
+
+static void bench_one(const char *name,
+		      double (*fn)(const struct libc_impl *impl, size_t size))
+{
+	unsigned int i;
+	size_t size;
+
+	printf("\n%s MB/s\n%10s", name, "size");
+	for (i = 0U; i < NUM_IMPLS; i++) {
+		printf(" %10s", impls[i].name);
+	}
+	printf("\n");
+
+	for (size = BENCH_MIN_SIZE; size <= BENCH_MAX_SIZE; size *= 4U) {
+		/* strlen runs over size - 1 bytes and the terminator */
+		fill(bench_src, size - 1U, 11U);
+		bench_src[size - 1U] = 0U;
+		memcpy(bench_dst, bench_src, size);
+
+		printf("%10zu", size);
+		for (i = 0U; i < NUM_IMPLS; i++) {
+			printf(" %10.0f", fn(&impls[i], size));
+		}
+		printf("\n");
+	}
+}
+
+static void bench(void)
+{
+	bench_one("memcpy", bench_memcpy);
+	bench_one("memmove", bench_memmove);
+	bench_one("memcmp", bench_memcmp);
+	bench_one("strlen", bench_strlen);
+}
+
+int main(int argc, char *argv[])
+{
+	const struct libc_impl *impl;
+
+	if ((argc == 2) && (strcmp(argv[1], "-b") == 0)) {
+		bench();
+		return 0;
+	}
+
+	for (impl = impls; impl < &impls[NUM_TESTED]; impl++) {
+		test_memcpy(impl);
+		test_memmove(impl);
+		test_memcmp(impl);
+		test_strlen(impl);
+	}
+
+	if (failures != 0U) {
+		printf("%u checks failed\n", failures);
+		return 1;
+	}
+
+	printf("All checks passed\n");
+
+	return 0;
+}
@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PLATFORM_DEF_H
+#define PLATFORM_DEF_H
+
+/* Minimal platform definitions needed by the SPMC headers */
+#define PLATFORM_CORE_COUNT		4
+#define CACHE_WRITEBACK_GRANULE		64
+#define PLAT_MAX_PWR_LVL		2
+#define PLAT_MAX_RET_STATE		1
+#define PLAT_MAX_OFF_STATE		2
+
+#endif /* PLATFORM_DEF_H */
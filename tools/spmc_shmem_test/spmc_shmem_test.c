@@ -0,0 +1,326 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Exercise the EL3 SPMC shared memory datastore allocator and its handle hash
+ * table. The firmware source is included as it is, so that its static
+ * functions can be called directly, and is built against the TF-A libc headers
+ * but linked with the host C library.
+ *
+ * A pseudo-random sequence of allocations and frees, including the temporary
+ * objects used for FF-A v1.0 descriptor conversion, is checked against a
+ * simple model after every step:
+ * - the blocks tile the whole datastore, and free blocks are never adjacent,
+ * - the free list holds every free block, in address order,
+ * - the allocated byte count matches the blocks in use,
+ * - every live handle is found, at an object that has not moved or been
+ *   overwritten, and freed handles are not found,
+ * - spmc_shmem_obj_get_next() returns exactly the live objects.
+ *
+ * With -b, it instead measures share, retrieve and reclaim churn with more and
+ * more shares outstanding.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <host_test.h>
+
+#include "../../services/std_svc/spm/el3_spmc/spmc_shared_mem.c"
+
+#define DATASTORE_SIZE	(64U * 1024U)
+#define MAX_LIVE	256U
+#define STEPS		100000U
+
+/* The benchmark runs with up to BENCH_MAX_LIVE shares outstanding */
+#define BENCH_DATASTORE_SIZE	(1024U * 1024U)
+#define BENCH_MAX_LIVE		1024U
+#define BENCH_OPS		200000U
+
+static uint8_t datastore[DATASTORE_SIZE] __aligned(16);
+static uint8_t bench_datastore[BENCH_DATASTORE_SIZE] __aligned(16);
+static uint64_t bench_handles[BENCH_MAX_LIVE];
+
+static struct {
+	struct spmc_shmem_obj *obj;
+	uint64_t handle;
+	size_t desc_size;
+} live[MAX_LIVE];
+static unsigned int live_count;
+
+static uint32_t rand_state = 1U;
+
+/* Host replacement for the firmware assertion handler */
+void __assert(const char *file, unsigned int line)
+{
+	printf("ASSERT: %s:%u\n", file, line);
+	exit(1);
+	__builtin_unreachable();
+}
+
+#define CHECK(cond, ...)						\
+	do {								\
+		if (!(cond)) {						\
+			printf("FAIL: " __VA_ARGS__);			\
+			exit(1);					\
+		}							\
+	} while (0)
+
+static uint32_t next_rand(void)
+{
+	rand_state = (rand_state * 1103515245U) + 12345U;
+
+	return rand_state >> 8;
+}
+
+/* Fill the descriptor of an object with a pattern derived from its handle */
+static void fill_obj(struct spmc_shmem_obj *obj, uint64_t handle)
+{
+	uint8_t *p = (uint8_t *)&obj->desc;
+	size_t i;
+
+	obj->desc.handle = handle;
+	for (i = sizeof(struct ffa_mtd); i < obj->desc_size; i++) {
+		p[i] = (uint8_t)(handle + i);
+	}
+}
+
+static bool obj_intact(const struct spmc_shmem_obj *obj, uint64_t handle)
+{
+	const uint8_t *p = (const uint8_t *)&obj->desc;
+	size_t i;
+
+	for (i = sizeof(struct ffa_mtd); i < obj->desc_size; i++) {
+		if (p[i] != (uint8_t)(handle + i)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void check_state(struct spmc_shmem_obj_state *state, uint64_t freed)
+{
+	struct spmc_shmem_obj *blk, *free_blk, *obj;
+	size_t offset = 0U, allocated = 0U;
+	unsigned int i, found = 0U;
+	bool prev_free = false;
+
+	/* Walk the blocks, following the free list alongside */
+	free_blk = state->free_list;
+	while (offset < state->data_size) {
+		blk = (struct spmc_shmem_obj *)(state->data + offset);
+		CHECK((blk->block_size >= SPMC_SHMEM_MIN_BLOCK_SIZE) &&
+		      is_aligned(blk->block_size, SPMC_SHMEM_BLOCK_ALIGN),
+		      "bad block size 0x%zx at 0x%zx\n", blk->block_size,
+		      offset);
+		if (blk->free) {
+			CHECK(!prev_free, "adjacent free blocks at 0x%zx\n",
+			      offset);
+			CHECK(blk == free_blk,
+			      "free block at 0x%zx not next on free list\n",
+			      offset);
+			free_blk = free_blk->next;
+		} else {
+			allocated += blk->block_size;
+		}
+		prev_free = blk->free;
+		offset += blk->block_size;
+	}
+	CHECK(offset == state->data_size, "blocks overrun the datastore\n");
+	CHECK(free_blk == NULL, "free list has blocks not in the datastore\n");
+	CHECK(allocated == state->allocated, "allocated 0x%zx, expected 0x%zx\n",
+	      state->allocated, allocated);
+
+	for (i = 0U; i < live_count; i++) {
+		obj = spmc_shmem_obj_lookup(state, live[i].handle);
+		CHECK(obj == live[i].obj, "handle 0x%llx not found\n",
+		      (unsigned long long)live[i].handle);
+		CHECK(obj_intact(obj, live[i].handle),
+		      "object 0x%llx overwritten\n",
+		      (unsigned long long)live[i].handle);
+	}
+
+	CHECK(spmc_shmem_obj_lookup(state, freed) == NULL,
+	      "freed handle 0x%llx still found\n", (unsigned long long)freed);
+
+	offset = 0U;
+	while ((obj = spmc_shmem_obj_get_next(state, &offset)) != NULL) {
+		for (i = 0U; i < live_count; i++) {
+			if (live[i].obj == obj) {
+				break;
+			}
+		}
+		CHECK(i < live_count, "get_next returned a dead object\n");
+		found++;
+	}
+	CHECK(found == live_count, "get_next found %u objects, expected %u\n",
+	      found, live_count);
+}
+
+static void do_alloc(struct spmc_shmem_obj_state *state)
+{
+	struct spmc_shmem_obj *obj, *tmp;
+	size_t desc_size;
+	uint64_t handle;
+
+	/* Mostly small descriptors, with the occasional large one */
+	desc_size = sizeof(struct ffa_mtd) + ((next_rand() % 8U) * 16U);
+	if ((next_rand() % 16U) == 0U) {
+		desc_size += (next_rand() % 256U) * 16U;
+	}
+
+	obj = spmc_shmem_obj_alloc(state, desc_size);
+	if (obj == NULL) {
+		return;
+	}
+
+	handle = state->next_handle++;
+	fill_obj(obj, handle);
+	spmc_shmem_obj_publish(state, obj);
+
+	/* Replace some with a converted copy, as for FF-A v1.0 senders */
+	if ((next_rand() % 4U) == 0U) {
+		tmp = spmc_shmem_obj_alloc(state, desc_size + 16U);
+		if (tmp != NULL) {
+			fill_obj(tmp, handle);
+			/* Not published yet, must not shadow the original */
+			CHECK(spmc_shmem_obj_lookup(state, handle) == obj,
+			      "temporary object shadows 0x%llx\n",
+			      (unsigned long long)handle);
+			spmc_shmem_obj_free(state, obj);
+			spmc_shmem_obj_publish(state, tmp);
+			obj = tmp;
+		}
+	}
+
+	live[live_count].obj = obj;
+	live[live_count].handle = handle;
+	live[live_count].desc_size = obj->desc_size;
+	live_count++;
+}
+
+static uint64_t do_free(struct spmc_shmem_obj_state *state)
+{
+	unsigned int i = next_rand() % live_count;
+	uint64_t handle = live[i].handle;
+
+	spmc_shmem_obj_free(state, live[i].obj);
+	live[i] = live[--live_count];
+
+	return handle;
+}
+
+/* Share an object, as FFA_MEM_SHARE does, and return its handle */
+static uint64_t bench_share(struct spmc_shmem_obj_state *state)
+{
+	struct spmc_shmem_obj *obj;
+	size_t desc_size;
+
+	desc_size = sizeof(struct ffa_mtd) + ((next_rand() % 8U) * 16U);
+	obj = spmc_shmem_obj_alloc(state, desc_size);
+	CHECK(obj != NULL, "datastore full\n");
+
+	obj->desc.handle = state->next_handle++;
+	spmc_shmem_obj_publish(state, obj);
+
+	return obj->desc.handle;
+}
+
+/*
+ * Return the rate of operations with 'nlive' shares outstanding, where each
+ * operation retrieves a random outstanding share by handle, reclaims the
+ * oldest one and shares a new object in its place.
+ */
+static double bench_churn(struct spmc_shmem_obj_state *state,
+			  unsigned int nlive)
+{
+	struct spmc_shmem_obj *obj;
+	unsigned int i, op;
+	double start;
+
+	state->data = bench_datastore;
+	state->data_size = sizeof(bench_datastore);
+	spmc_shmem_obj_state_init(state);
+
+	for (i = 0U; i < nlive; i++) {
+		bench_handles[i] = bench_share(state);
+	}
+
+	start = host_test_time();
+	for (op = 0U; op < BENCH_OPS; op++) {
+		/* Retrieve */
+		obj = spmc_shmem_obj_lookup(state,
+					    bench_handles[next_rand() % nlive]);
+		CHECK(obj != NULL, "retrieve failed\n");
+
+		/* Reclaim the oldest share, which is in slot op % nlive */
+		i = op % nlive;
+		obj = spmc_shmem_obj_lookup(state, bench_handles[i]);
+		CHECK(obj != NULL, "reclaim failed\n");
+		spmc_shmem_obj_free(state, obj);
+
+		bench_handles[i] = bench_share(state);
+	}
+
+	return (double)BENCH_OPS / (host_test_time() - start);
+}
+
+static void bench(struct spmc_shmem_obj_state *state)
+{
+	unsigned int nlive;
+
+	printf("%12s %16s\n", "outstanding", "ops/s");
+	for (nlive = 16U; nlive <= BENCH_MAX_LIVE; nlive *= 4U) {
+		printf("%12u %16.0f\n", nlive, bench_churn(state, nlive));
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	struct spmc_shmem_obj_state *state = &spmc_shmem_obj_state;
+	unsigned int step, allocs = 0U;
+	uint64_t freed = 0U;
+
+	if ((argc == 2) && (strcmp(argv[1], "-b") == 0)) {
+		bench(state);
+		return 0;
+	}
+
+	state->data = datastore;
+	state->data_size = sizeof(datastore);
+	spmc_shmem_obj_state_init(state);
+	check_state(state, freed);
+
+	for (step = 0U; step < STEPS; step++) {
+		/* Bias towards filling up, then drain, then fill again */
+		if ((live_count < MAX_LIVE) &&
+		    ((live_count == 0U) ||
+		     ((next_rand() % 100U) < ((step / 5000U) % 2U ? 30U : 70U)))) {
+			do_alloc(state);
+			allocs++;
+		} else {
+			freed = do_free(state);
+		}
+		check_state(state, freed);
+	}
+
+	while (live_count != 0U) {
+		freed = do_free(state);
+		check_state(state, freed);
+	}
+
+	/* Everything freed must have merged back into a single block */
+	CHECK((state->free_list == (struct spmc_shmem_obj *)datastore) &&
+	      (state->free_list->block_size == sizeof(datastore)) &&
+	      (state->allocated == 0U),
+	      "datastore not a single free block once empty\n");
+
+	printf("%u steps, %u allocations: all checks passed\n", STEPS, allocs);
+
+	return 0;
+}
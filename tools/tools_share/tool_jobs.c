@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <limits.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "tool_jobs.h"
+
+/* Work shared by the threads of tool_jobs_run() */
+typedef struct job_queue {
+	pthread_mutex_t lock;
+	void (*fn)(void *arg, int i);
+	void *arg;
+	int num;
+	int next;
+} job_queue_t;
+
+int tool_jobs_parse(const char *num_jobs_str)
+{
+	char *end;
+	long num_jobs;
+
+	num_jobs = strtol(num_jobs_str, &end, 10);
+	if ((*end != '\0') || (num_jobs <= 0) || (num_jobs > INT_MAX)) {
+		return -1;
+	}
+
+	return num_jobs;
+}
+
+int tool_jobs_default(void)
+{
+	long num_jobs = sysconf(_SC_NPROCESSORS_ONLN);
+
+	if ((num_jobs <= 0) || (num_jobs > INT_MAX)) {
+		return 1;
+	}
+
+	return num_jobs;
+}
+
+static void *job_thread(void *arg)
+{
+	job_queue_t *queue = arg;
+	int i;
+
+	while (1) {
+		pthread_mutex_lock(&queue->lock);
+		i = queue->next;
+		if (i < queue->num) {
+			queue->next++;
+		}
+		pthread_mutex_unlock(&queue->lock);
+
+		if (i >= queue->num) {
+			break;
+		}
+
+		queue->fn(queue->arg, i);
+	}
+
+	return NULL;
+}
+
+void tool_jobs_run(int num_jobs, void (*fn)(void *arg, int i), void *arg,
+		   int num)
+{
+	job_queue_t queue = {
+		.lock = PTHREAD_MUTEX_INITIALIZER,
+		.fn = fn,
+		.arg = arg,
+		.num = num,
+		.next = 0
+	};
+	pthread_t *threads;
+	int i, num_threads = 0;
+
+	threads = malloc(num_jobs * sizeof(threads[0]));
+
+	/* Fewer threads only make things slower, not wrong */
+	for (i = 1; (threads != NULL) && (i < num_jobs) && (i < num); i++) {
+		if (pthread_create(&threads[num_threads], NULL, job_thread,
+				   &queue) != 0) {
+			break;
+		}
+		num_threads++;
+	}
+
+	job_thread(&queue);
+
+	for (i = 0; i < num_threads; i++) {
+		pthread_join(threads[i], NULL);
+	}
+
+	free(threads);
+}